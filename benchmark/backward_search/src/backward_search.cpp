@@ -0,0 +1,97 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sdsl/csa_wt.hpp>
+#include <sdsl/suffix_array_algorithm.hpp>
+
+using namespace std;
+using namespace sdsl;
+
+using namespace std::chrono;
+using timer = std::chrono::high_resolution_clock;
+
+#ifndef CSA_TYPE
+#    define CSA_TYPE csa_wt<wt_huff<>>
+#endif
+
+typedef CSA_TYPE csa_type;
+typedef csa_type::size_type size_type;
+
+//! Counts the patterns with the pattern overload of backward_search
+uint64_t count_pattern(csa_type const & csa, vector<string> const & patterns)
+{
+    uint64_t check = 0;
+    size_type l_res, r_res;
+    for (auto const & pat : patterns)
+    {
+        check += backward_search(csa, 0, csa.size() - 1, pat.begin(), pat.end(), l_res, r_res);
+    }
+    return check;
+}
+
+//! Counts the patterns by calling the single character backward_search for each symbol
+uint64_t count_chars(csa_type const & csa, vector<string> const & patterns)
+{
+    uint64_t check = 0;
+    for (auto const & pat : patterns)
+    {
+        size_type l = 0, r = csa.size() - 1;
+        for (auto it = pat.end(); it != pat.begin() and r + 1 - l > 0;)
+        {
+            --it;
+            backward_search(csa, l, r, (csa_type::char_type)*it, l, r);
+        }
+        check += r + 1 - l;
+    }
+    return check;
+}
+
+int main(int argc, char * argv[])
+{
+    if (argc < 4)
+    {
+        cout << "Usage: " << argv[0] << " text_file pattern_length patterns" << endl;
+        cout << " builds a CSA for text_file and compares the pattern overload of backward_search" << endl;
+        cout << " with a character by character search on patterns sampled from the text" << endl;
+        return 1;
+    }
+    uint64_t m = stoull(argv[2]);
+    uint64_t cnt = stoull(argv[3]);
+
+    int_vector<8> text;
+    if (!load_vector_from_file(text, argv[1], 1) or text.size() <= m)
+    {
+        cout << "Could not load a text longer than " << m << " from " << argv[1] << endl;
+        return 1;
+    }
+    vector<string> patterns;
+    mt19937_64 rng(17);
+    for (uint64_t i = 0; i < cnt; ++i)
+    {
+        uint64_t pos = rng() % (text.size() - m);
+        patterns.emplace_back(text.begin() + pos, text.begin() + pos + m);
+    }
+
+    csa_type csa;
+    auto start = timer::now();
+    construct(csa, argv[1], 1);
+    auto stop = timer::now();
+    cout << "# construct_time = " << duration_cast<milliseconds>(stop - start).count() << endl;
+    cout << "# csa_size = " << size_in_bytes(csa) << endl;
+
+    double chars = cnt * m;
+    start = timer::now();
+    uint64_t check_pattern = count_pattern(csa, patterns);
+    stop = timer::now();
+    cout << "# pattern_time_per_char = " << duration_cast<nanoseconds>(stop - start).count() / chars << endl;
+    start = timer::now();
+    uint64_t check_chars = count_chars(csa, patterns);
+    stop = timer::now();
+    cout << "# char_time_per_char = " << duration_cast<nanoseconds>(stop - start).count() / chars << endl;
+    cout << "# check_pattern = " << check_pattern << endl;
+    cout << "# check_chars = " << check_chars << endl;
+    return check_pattern != check_chars;
+}
@@ -13,6 +13,7 @@
 #include <sdsl/bit_vector_il.hpp>
 #include <sdsl/hyb_vector.hpp>
 #include <sdsl/int_vector.hpp>
+#include <sdsl/mix_vector.hpp>
 #include <sdsl/rrr_vector.hpp>
 #include <sdsl/sd_vector.hpp>
 // Cyclic includes end
@@ -0,0 +1,272 @@
+// Copyright (c) 2016, the SDSL Project Authors.  All rights reserved.
+// Please see the AUTHORS file for details.  Use of this source code is governed
+// by a BSD license that can be found in the LICENSE file.
+/*!\file block_text.hpp
+ * \brief block_text.hpp contains a block-compressed text with constant time access to each block.
+ */
+#ifndef INCLUDED_SDSL_BLOCK_TEXT
+#define INCLUDED_SDSL_BLOCK_TEXT
+
+#include <algorithm>
+#include <iosfwd>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <sdsl/bits.hpp>
+#include <sdsl/cereal.hpp>
+#include <sdsl/int_vector.hpp>
+#include <sdsl/io.hpp>
+#include <sdsl/iterators.hpp>
+#include <sdsl/structure_tree.hpp>
+#include <sdsl/util.hpp>
+
+namespace sdsl
+{
+
+//! A block-compressed plain text.
+/*! The text is divided into blocks of t_block_size symbols. Each block stores the sorted set of its
+ *  distinct symbols and the text of the block as fixed-width codes of \f$\lceil\log\sigma_b\rceil\f$
+ *  bits, where \f$\sigma_b\f$ is the number of distinct symbols of the block. A block index holds the
+ *  offsets of the codes and the local alphabets of all blocks.
+ *
+ *  Substrings are decoded by sequential reads of codes and one table lookup per symbol, which makes
+ *  the structure a fast backend for extract, see csa_text.
+ *
+ * \tparam t_block_size Number of symbols per block.
+ *
+ * \par Space complexity
+ *   \f$ n\lceil\log\sigma_b\rceil \f$ bits for the codes plus \f$\Order{(n/b)(\sigma_b+1)\log\sigma}\f$ bits
+ *   for the block index.
+ */
+template <uint32_t t_block_size = 4096>
+class block_text
+{
+    static_assert(t_block_size > 0, "block_text: block size has to be larger than 0");
+
+public:
+    typedef uint64_t value_type;
+    typedef int_vector<>::size_type size_type;
+    typedef ptrdiff_t difference_type;
+    typedef random_access_const_iterator<block_text> const_iterator;
+    typedef const_iterator iterator;
+    typedef const value_type const_reference;
+    typedef const_reference reference;
+
+    enum
+    {
+        block_size = t_block_size
+    };
+
+private:
+    size_type m_size = 0;
+    int_vector<> m_codes;     // concatenated codes of all blocks
+    int_vector<> m_code_pos;  // bit offset of the codes of block b in m_codes
+    int_vector<8> m_width;    // code width of block b
+    int_vector<> m_syms;      // concatenated local alphabets
+    int_vector<> m_syms_pos;  // m_syms_pos[b] is the position of the local alphabet of block b in m_syms
+
+    size_type blocks() const
+    {
+        return (m_size + t_block_size - 1) / t_block_size;
+    }
+
+public:
+    block_text() = default;
+
+    //! Constructor
+    /*!\param begin Iterator to the first symbol of the text.
+     * \param end   Iterator past the last symbol of the text.
+     */
+    template <class t_iter>
+    block_text(t_iter begin, t_iter end)
+    {
+        m_size = end - begin;
+        size_type bc = blocks();
+        std::vector<uint64_t> syms, block;
+        std::vector<size_type> sigmas(bc);
+        size_type total_bits = 0;
+        uint64_t max_sym = 0;
+        m_width = int_vector<8>(bc, 0);
+        // (1) determine the local alphabets and code widths
+        for (size_type b = 0; b < bc; ++b)
+        {
+            auto first = begin + b * t_block_size;
+            auto last = begin + std::min(m_size, (b + 1) * t_block_size);
+            block.assign(first, last);
+            std::sort(block.begin(), block.end());
+            block.erase(std::unique(block.begin(), block.end()), block.end());
+            m_width[b] = block.size() > 1 ? bits::hi(block.size() - 1) + 1 : 0;
+            total_bits += m_width[b] * (last - first);
+            sigmas[b] = block.size();
+            syms.insert(syms.end(), block.begin(), block.end());
+            max_sym = std::max(max_sym, block.back());
+        }
+        m_syms = int_vector<>(syms.size(), 0, bits::hi(max_sym) + 1);
+        std::copy(syms.begin(), syms.end(), m_syms.begin());
+        m_syms_pos = int_vector<>(bc + 1, 0, bits::hi(syms.size()) + 1);
+        m_code_pos = int_vector<>(bc + 1, 0, bits::hi(total_bits) + 1);
+        m_codes = int_vector<>((total_bits + 63) / 64, 0, 64);
+        // (2) encode the blocks
+        size_type sym_pos = 0, code_pos = 0;
+        for (size_type b = 0; b < bc; ++b)
+        {
+            auto first = begin + b * t_block_size;
+            auto last = begin + std::min(m_size, (b + 1) * t_block_size);
+            m_syms_pos[b] = sym_pos;
+            m_code_pos[b] = code_pos;
+            auto sfirst = syms.begin() + sym_pos, slast = sfirst + sigmas[b];
+            uint8_t w = m_width[b];
+            for (auto it = first; it != last; ++it)
+            {
+                uint64_t code = std::lower_bound(sfirst, slast, (uint64_t)*it) - sfirst;
+                if (w > 0)
+                    bits::write_int(m_codes.data() + (code_pos >> 6), code, code_pos & 0x3F, w);
+                code_pos += w;
+            }
+            sym_pos += sigmas[b];
+        }
+        m_syms_pos[bc] = sym_pos;
+        m_code_pos[bc] = code_pos;
+    }
+
+    //! Number of symbols of the text.
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    //! Returns if the text is empty.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    //! Symbol at position i.
+    /*!\par Time complexity
+     *      \f$ \Order{1} \f$
+     */
+    value_type operator[](size_type i) const
+    {
+        assert(i < m_size);
+        size_type b = i / t_block_size;
+        uint8_t w = m_width[b];
+        uint64_t code = 0;
+        if (w > 0)
+        {
+            size_type pos = m_code_pos[b] + (i % t_block_size) * w;
+            code = bits::read_int(m_codes.data() + (pos >> 6), pos & 0x3F, w);
+        }
+        return m_syms[m_syms_pos[b] + code];
+    }
+
+    //! Writes the symbols at positions [begin..end] to text[0..end-begin].
+    /*!\param begin Position of the first symbol (inclusive).
+     * \param end   Position of the last symbol (inclusive).
+     * \param text  Random access iterator to a container which can hold at least end-begin+1 symbols.
+     * \return The number of written symbols.
+     * \par Time complexity
+     *      \f$ \Order{end-begin+1} \f$
+     */
+    template <class t_text_iter>
+    size_type extract(size_type begin, size_type end, t_text_iter text) const
+    {
+        assert(begin <= end and end < m_size);
+        size_type i = begin;
+        while (i <= end)
+        {
+            size_type b = i / t_block_size;
+            size_type last = std::min(end + 1, (b + 1) * t_block_size);
+            uint8_t w = m_width[b];
+            size_type sp = m_syms_pos[b];
+            if (w == 0)
+            {
+                auto c = m_syms[sp];
+                for (; i < last; ++i, ++text)
+                    *text = c;
+                continue;
+            }
+            size_type pos = m_code_pos[b] + (i % t_block_size) * w;
+            uint64_t const * data = m_codes.data() + (pos >> 6);
+            uint8_t offset = pos & 0x3F;
+            for (; i < last; ++i, ++text)
+            {
+                *text = m_syms[sp + bits::read_int_and_move(data, offset, w)];
+            }
+        }
+        return end - begin + 1;
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, size());
+    }
+
+    //! Serializes the data structure into the given ostream
+    size_type serialize(std::ostream & out, structure_tree_node * v = nullptr, std::string name = "") const
+    {
+        structure_tree_node * child = structure_tree::add_child(v, name, util::class_name(*this));
+        size_type written_bytes = 0;
+        written_bytes += write_member(m_size, out, child, "size");
+        written_bytes += m_codes.serialize(out, child, "codes");
+        written_bytes += m_code_pos.serialize(out, child, "code_pos");
+        written_bytes += m_width.serialize(out, child, "width");
+        written_bytes += m_syms.serialize(out, child, "syms");
+        written_bytes += m_syms_pos.serialize(out, child, "syms_pos");
+        structure_tree::add_size(child, written_bytes);
+        return written_bytes;
+    }
+
+    //! Loads the data structure from the given istream.
+    void load(std::istream & in)
+    {
+        read_member(m_size, in);
+        m_codes.load(in);
+        m_code_pos.load(in);
+        m_width.load(in);
+        m_syms.load(in);
+        m_syms_pos.load(in);
+    }
+
+    template <typename archive_t>
+    void CEREAL_SAVE_FUNCTION_NAME(archive_t & ar) const
+    {
+        ar(CEREAL_NVP(m_size));
+        ar(CEREAL_NVP(m_codes));
+        ar(CEREAL_NVP(m_code_pos));
+        ar(CEREAL_NVP(m_width));
+        ar(CEREAL_NVP(m_syms));
+        ar(CEREAL_NVP(m_syms_pos));
+    }
+
+    template <typename archive_t>
+    void CEREAL_LOAD_FUNCTION_NAME(archive_t & ar)
+    {
+        ar(CEREAL_NVP(m_size));
+        ar(CEREAL_NVP(m_codes));
+        ar(CEREAL_NVP(m_code_pos));
+        ar(CEREAL_NVP(m_width));
+        ar(CEREAL_NVP(m_syms));
+        ar(CEREAL_NVP(m_syms_pos));
+    }
+
+    bool operator==(block_text const & other) const noexcept
+    {
+        return (m_size == other.m_size) && (m_codes == other.m_codes) && (m_code_pos == other.m_code_pos)
+            && (m_width == other.m_width) && (m_syms == other.m_syms) && (m_syms_pos == other.m_syms_pos);
+    }
+
+    bool operator!=(block_text const & other) const noexcept
+    {
+        return !(*this == other);
+    }
+};
+
+} // end namespace sdsl
+
+#endif
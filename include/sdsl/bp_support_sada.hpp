@@ -13,6 +13,7 @@
 #include <stdint.h>
 
 #include <sdsl/bp_support_algorithm.hpp>
+#include <sdsl/fast_cache.hpp>
 #include <sdsl/int_vector.hpp>
 #include <sdsl/rank_support_v.hpp>
 #include <sdsl/rank_support_v5.hpp>
@@ -87,12 +88,7 @@ private:
     size_type m_sml_blocks = 0;       // number of small sized blocks
     size_type m_med_blocks = 0;       // number of medium sized blocks
     size_type m_med_inner_blocks = 0; // number of inner nodes in the min max tree of the medium sized blocks
-//#define USE_CACHE
-#ifdef USE_CACHE
-    mutable fast_cache find_close_cache;
-    mutable fast_cache find_open_cache;
-    mutable fast_cache select_cache;
-#endif
+    query_cache_id m_cache_id;        // identifies the answers in the query cache, see query_cache_config
 
     static inline size_type sml_block_idx(size_type i)
     {
@@ -411,6 +407,7 @@ public:
             m_sml_blocks = std::move(bp_support.m_sml_blocks);
             m_med_blocks = std::move(bp_support.m_med_blocks);
             m_med_inner_blocks = std::move(bp_support.m_med_inner_blocks);
+            m_cache_id.renew();
         }
         return *this;
     }
@@ -504,6 +501,7 @@ public:
         m_bp = bp;
         m_bp_rank.set_vector(bp);
         m_bp_select.set_vector(bp);
+        m_cache_id.renew();
     }
 
     /*! Calculates the excess value at index i.
@@ -529,20 +527,13 @@ public:
      */
     size_type select(size_type i) const
     {
-#ifdef USE_CACHE
-        size_type a = 0;
-        if (select_cache.exists(i, a))
-        {
-            return a;
-        }
-        else
-        {
-            a = m_bp_select(i);
-            select_cache.write(i, a);
-            return a;
-        }
-#endif
-        return m_bp_select(i);
+        return cached_query(query_cache_kind::select,
+                            m_cache_id,
+                            i,
+                            [&]()
+                            {
+                                return m_bp_select(i);
+                            });
     }
 
     /*! Calculate the index of the matching closing parenthesis to the parenthesis at index i.
@@ -558,20 +549,13 @@ public:
         { // if there is a closing parenthesis at index i return i
             return i;
         }
-#ifdef USE_CACHE
-        size_type a = 0;
-        if (find_close_cache.exists(i, a))
-        {
-            return a;
-        }
-        else
-        {
-            a = fwd_excess(i, -1);
-            find_close_cache.write(i, a);
-            return a;
-        }
-#endif
-        return fwd_excess(i, -1);
+        return cached_query(query_cache_kind::find_close,
+                            m_cache_id,
+                            i,
+                            [&]()
+                            {
+                                return fwd_excess(i, -1);
+                            });
     }
 
     //! Calculate the matching opening parenthesis to the closing parenthesis at position i
@@ -587,28 +571,17 @@ public:
         { // if there is a opening parenthesis at index i return i
             return i;
         }
-#ifdef USE_CACHE
-        size_type a = 0;
-        if (find_open_cache.exists(i, a))
-        {
-            return a;
-        }
-        else
-        {
-            size_type bwd_ex = bwd_excess(i, 0);
-            if (bwd_ex == size())
-                a = size();
-            else
-                a = bwd_ex + 1;
-            find_open_cache.write(i, a);
-            return a;
-        }
-#endif
-        size_type bwd_ex = bwd_excess(i, 0);
-        if (bwd_ex == size())
-            return size();
-        else
-            return bwd_ex + 1;
+        return cached_query(query_cache_kind::find_open,
+                            m_cache_id,
+                            i,
+                            [&]()
+                            {
+                                size_type bwd_ex = bwd_excess(i, 0);
+                                if (bwd_ex == size())
+                                    return size();
+                                else
+                                    return bwd_ex + 1;
+                            });
     }
 
     //! Calculate the index of the opening parenthesis corresponding to the closest matching parenthesis pair enclosing
@@ -1015,6 +988,7 @@ public:
 
         m_sml_block_min_max.load(in);
         m_med_block_min_max.load(in);
+        m_cache_id.renew();
     }
 
     template <typename archive_t>
@@ -1041,6 +1015,7 @@ public:
         ar(CEREAL_NVP(m_bp_select));
         ar(CEREAL_NVP(m_sml_block_min_max));
         ar(CEREAL_NVP(m_med_block_min_max));
+        m_cache_id.renew();
     }
 
     //! Equality operator.
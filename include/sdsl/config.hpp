@@ -42,6 +42,9 @@ constexpr char KEY_TEXT_INT[] = "text_int";
 constexpr char KEY_PSI[] = "psi";
 constexpr char KEY_LCP[] = "lcp";
 constexpr char KEY_SAMPLE_CHAR[] = "sample_char";
+constexpr char KEY_SA_SAMPLE[] = "sa_sample";
+constexpr char KEY_ISA_SAMPLE[] = "isa_sample";
+constexpr char KEY_LZ77[] = "lz77";
 } // namespace conf
 
 typedef uint64_t int_vector_size_type;
@@ -146,6 +149,18 @@ using key_text_trait = key_text_trait_impl<width, void>;
 template <uint8_t width>
 using key_bwt_trait = key_bwt_trait_impl<width, void>;
 
+//! Cache key of the suffix array samples SA[i] with \f$ i \equiv 0 \mod dens \f$.
+inline std::string key_sa_sample(uint64_t dens)
+{
+    return std::string(conf::KEY_SA_SAMPLE) + "_" + util::to_string(dens);
+}
+
+//! Cache key of the inverse suffix array samples ISA[j] with \f$ j \equiv 0 \mod dens \f$.
+inline std::string key_isa_sample(uint64_t dens)
+{
+    return std::string(conf::KEY_ISA_SAMPLE) + "_" + util::to_string(dens);
+}
+
 } // namespace sdsl
 
 #endif
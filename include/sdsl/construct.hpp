@@ -52,6 +52,16 @@ void append_zero_symbol(int_vector & text)
     text[text.size() - 1] = 0;
 }
 
+//! Checks if a sampling type can be built from samples stored in the cache (see construct_bwt).
+template <class t_sample, class = void>
+struct has_cached_samples : std::false_type
+{};
+
+template <class t_sample>
+struct has_cached_samples<t_sample, std::void_t<decltype(t_sample::cached_samples)>> :
+    std::integral_constant<bool, t_sample::cached_samples>
+{};
+
 template <class t_index>
 void construct(t_index & idx, std::string file, uint8_t num_bytes = 0, bool move_input = false)
 {
@@ -162,10 +172,26 @@ void construct(t_index & idx, std::string const & file, cache_config & config, u
     {
         sdsl::remove(file);
     }
+    // extract sparse samples during the BWT construction, if the sampling strategies can use them
+    uint64_t sa_dens = 0, isa_dens = 0;
+    if (has_cached_samples<typename t_index::sa_sample_type>::value and t_index::sa_sample_dens > 1)
+        sa_dens = t_index::sa_sample_dens;
+    if (has_cached_samples<typename t_index::isa_sample_type>::value and t_index::isa_sample_dens > 1)
+        isa_dens = t_index::isa_sample_dens;
+    // the full SA is only kept for later use (e.g. LCP construction), if the temporary files are not deleted
+    bool sa_free = width == 8 and sa_dens > 0 and isa_dens > 0 and construct_config().sa_free_bwt
+               and config.delete_files and !cache_file_exists(conf::KEY_SA, config)
+               and !cache_file_exists(KEY_BWT, config);
+    if (sa_free)
+    {
+        //  (2+3) the full SA is not needed, construct the BWT and the samples directly
+        auto event = memory_monitor::event("BWT");
+        construct_bwt_is(config, sa_dens, isa_dens);
+    }
     {
         // (2) check, if the suffix array is cached
         auto event = memory_monitor::event("SA");
-        if (!cache_file_exists(conf::KEY_SA, config))
+        if (!sa_free and !cache_file_exists(conf::KEY_SA, config))
         {
             construct_sa<t_index::alphabet_category::WIDTH>(config);
         }
@@ -176,7 +202,7 @@ void construct(t_index & idx, std::string const & file, cache_config & config, u
         auto event = memory_monitor::event("BWT");
         if (!cache_file_exists(KEY_BWT, config))
         {
-            construct_bwt<t_index::alphabet_category::WIDTH>(config);
+            construct_bwt<t_index::alphabet_category::WIDTH>(config, sa_dens, isa_dens);
         }
         register_cache_file(KEY_BWT, config);
     }
@@ -8,34 +8,81 @@
 #ifndef INCLUDED_SDSL_CONSTRUCT_BWT
 #define INCLUDED_SDSL_CONSTRUCT_BWT
 
+#include <algorithm>
 #include <iostream>
 #include <stdint.h>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include <sdsl/bits.hpp>
 #include <sdsl/config.hpp>
+#include <sdsl/construct_config.hpp>
+#include <sdsl/divsufsort.hpp>
 #include <sdsl/int_vector.hpp>
 #include <sdsl/int_vector_buffer.hpp>
 #include <sdsl/int_vector_mapper.hpp>
 #include <sdsl/io.hpp>
 #include <sdsl/ram_fs.hpp>
+#include <sdsl/util.hpp>
 
 namespace sdsl
 {
 
+// Computes bwt[k] = text[sa[k]-1] for k in [0..len-1], where the text is accessed in
+// increasing order of positions. The suffixes are bucketed by the most significant
+// bits of the preceding text position, so that each bucket only touches a small part
+// of the text.
+template <class t_text>
+void _construct_bwt_block(t_text const & text, uint64_t n, uint64_t const * sa, uint64_t * bwt, uint64_t len)
+{
+    const uint8_t bucket_bits = 16;
+    uint8_t shift = bits::hi(n) >= bucket_bits ? bits::hi(n) + 1 - bucket_bits : 0;
+    std::vector<uint64_t> bucket((((n - 1) >> shift) + 2), 0);
+    for (uint64_t k = 0; k < len; ++k)
+    {
+        uint64_t pos = sa[k] > 0 ? sa[k] - 1 : n - 1;
+        ++bucket[(pos >> shift) + 1];
+    }
+    for (uint64_t b = 1; b < bucket.size(); ++b)
+    {
+        bucket[b] += bucket[b - 1];
+    }
+    std::vector<std::pair<uint64_t, uint64_t>> order(len);
+    for (uint64_t k = 0; k < len; ++k)
+    {
+        uint64_t pos = sa[k] > 0 ? sa[k] - 1 : n - 1;
+        order[bucket[pos >> shift]++] = {pos, k};
+    }
+    for (auto const & p : order)
+    {
+        bwt[p.second] = text[p.first];
+    }
+}
+
 //! Constructs the Burrows and Wheeler Transform (BWT) from text over byte- or integer-alphabet and suffix array.
 /*!	The algorithm constructs the BWT and stores it to disk.
  *  \tparam t_width Width of the text. 0==integer alphabet, 8=byte alphabet.
  *  \param config	Reference to cache configuration
+ *  \param sa_sample_dens  If not 0, the SA samples SA[i] with \f$ i \equiv 0 \mod sa\_sample\_dens \f$ are
+ *                         stored in the same pass under key_sa_sample(sa_sample_dens).
+ *  \param isa_sample_dens If not 0, the ISA samples ISA[j] with \f$ j \equiv 0 \mod isa\_sample\_dens \f$ are
+ *                         stored in the same pass under key_isa_sample(isa_sample_dens).
  *  \par Space complexity
- *		\f$ n \log \sigma \f$ bits
+ *		\f$ n \log \sigma \f$ bits plus a constant number of words per SA block and thread
  *  \pre Text and Suffix array exist in the cache. Keys:
  *         * conf::KEY_TEXT for t_width=8 or conf::KEY_TEXT_INT for t_width=0
  *         * conf::KEY_SA
  *  \post BWT exist in the cache. Key
  *         * conf::KEY_BWT for t_width=8 or conf::KEY_BWT_INT for t_width=0
+ *
+ *  The SA is streamed in blocks. Each block is distributed among construct_config().num_threads
+ *  threads, which sort their part by text position before accessing the text. This turns the
+ *  random text accesses into (almost) sequential ones.
  */
 template <uint8_t t_width>
-void construct_bwt(cache_config & config)
+void construct_bwt(cache_config & config, uint64_t sa_sample_dens = 0, uint64_t isa_sample_dens = 0)
 {
     static_assert(t_width == 0 or t_width == 8,
                   "construct_bwt: width must be `0` for integer alphabet and `8` for byte alphabet");
@@ -50,12 +97,54 @@ void construct_bwt(cache_config & config)
     uint8_t bwt_width = text.width();
     std::string bwt_file = cache_file_name(KEY_BWT, config);
 
-    auto gen_bwt = [&n](auto & bwt, auto & text, auto & sa)
+    int_vector<> sa_sample, isa_sample;
+    if (sa_sample_dens > 0)
     {
-        size_type to_add[2] = {(size_type)-1, n - 1};
-        for (size_type i = 0; i < n; ++i)
+        sa_sample = int_vector<>((n + sa_sample_dens - 1) / sa_sample_dens, 0, bits::hi(n) + 1);
+    }
+    if (isa_sample_dens > 0 and n > 0)
+    {
+        isa_sample = int_vector<>((n - 1) / isa_sample_dens + 1, 0, bits::hi(n) + 1);
+    }
+
+    uint64_t threads = std::max<uint64_t>(1, construct_config().num_threads);
+    const size_type block_size = 1 << 18;
+    auto gen_bwt = [&](auto & bwt, auto & sa)
+    {
+        std::vector<uint64_t> sa_block(std::min<size_type>(n, threads * block_size));
+        std::vector<uint64_t> bwt_block(sa_block.size());
+        for (size_type i = 0; i < n; i += sa_block.size())
         {
-            bwt[i] = text[sa[i] + to_add[sa[i] == 0]];
+            size_type len = std::min<size_type>(sa_block.size(), n - i);
+            for (size_type k = 0; k < len; ++k)
+            {
+                size_type sa_val = sa[i + k];
+                sa_block[k] = sa_val;
+                if (sa_sample_dens > 0 and (i + k) % sa_sample_dens == 0)
+                {
+                    sa_sample[(i + k) / sa_sample_dens] = sa_val;
+                }
+                if (isa_sample_dens > 0 and sa_val % isa_sample_dens == 0)
+                {
+                    isa_sample[sa_val / isa_sample_dens] = i + k;
+                }
+            }
+            size_type part = (len + threads - 1) / threads;
+            util::run_parallel(threads,
+                               [&](uint64_t t)
+                               {
+                                   size_type beg = std::min(len, t * part);
+                                   size_type end = std::min(len, beg + part);
+                                   _construct_bwt_block(text,
+                                                        n,
+                                                        sa_block.data() + beg,
+                                                        bwt_block.data() + beg,
+                                                        end - beg);
+                               });
+            for (size_type k = 0; k < len; ++k)
+            {
+                bwt[i + k] = bwt_block[k];
+            }
         }
     };
     //  (2) Prepare to stream SA from disc and BWT to disc
@@ -63,7 +152,7 @@ void construct_bwt(cache_config & config)
     {
         int_vector_mapper<> sa(conf::KEY_SA, config);
         auto bwt = write_out_mapper<t_width>::create(bwt_file, n, bwt_width);
-        gen_bwt(bwt, text, sa);
+        gen_bwt(bwt, sa);
     }
     else
     {
@@ -71,10 +160,89 @@ void construct_bwt(cache_config & config)
         std::string sa_file = cache_file_name(conf::KEY_SA, config);
         int_vector_buffer<> sa_buf(sa_file, std::ios::in, buffer_size);
         auto bwt = write_out_mapper<t_width>::create(bwt_file, n, bwt_width);
-        //  (3) Construct BWT sequentially by streaming SA and random access to text
-        gen_bwt(bwt, text, sa_buf);
+        //  (3) Construct BWT block-wise by streaming SA and sorted access to text
+        gen_bwt(bwt, sa_buf);
     }
     register_cache_file(KEY_BWT, config);
+    if (sa_sample_dens > 0)
+    {
+        store_to_cache(sa_sample, key_sa_sample(sa_sample_dens), config);
+    }
+    if (isa_sample_dens > 0)
+    {
+        store_to_cache(isa_sample, key_isa_sample(isa_sample_dens), config);
+    }
+}
+
+//! Constructs the Burrows and Wheeler Transform (BWT) of a byte text without the suffix array.
+/*!	The BWT is induced from the sorted type B* suffixes (see divsufsort) and the suffix array
+ *  is never stored. The SA and ISA samples are extracted during the induction.
+ *  \param config	Reference to cache configuration
+ *  \param sa_sample_dens  If not 0, the SA samples SA[i] with \f$ i \equiv 0 \mod sa\_sample\_dens \f$ are
+ *                         stored under key_sa_sample(sa_sample_dens).
+ *  \param isa_sample_dens If not 0, the ISA samples ISA[j] with \f$ j \equiv 0 \mod isa\_sample\_dens \f$ are
+ *                         stored under key_isa_sample(isa_sample_dens).
+ *  \par Space complexity
+ *		\f$ 5n \f$ bytes for inputs < 2GB, \f$ 9n \f$ bytes otherwise, plus the samples
+ *  \pre Text exist in the cache. Key:
+ *         * conf::KEY_TEXT
+ *  \post BWT exist in the cache. Key
+ *         * conf::KEY_BWT
+ */
+inline void construct_bwt_is(cache_config & config, uint64_t sa_sample_dens = 0, uint64_t isa_sample_dens = 0)
+{
+    typedef int_vector<>::size_type size_type;
+    int_vector<8> text;
+    load_from_cache(text, conf::KEY_TEXT, config);
+    size_type n = text.size();
+
+    int_vector<> sa_sample, isa_sample;
+    if (sa_sample_dens > 0)
+    {
+        sa_sample = int_vector<>((n + sa_sample_dens - 1) / sa_sample_dens, 0, bits::hi(n) + 1);
+    }
+    if (isa_sample_dens > 0 and n > 0)
+    {
+        isa_sample = int_vector<>((n - 1) / isa_sample_dens + 1, 0, bits::hi(n) + 1);
+    }
+    auto report = [&](uint64_t i, uint64_t sa)
+    {
+        if (sa_sample_dens > 0 and i % sa_sample_dens == 0)
+        {
+            sa_sample[i / sa_sample_dens] = sa;
+        }
+        if (isa_sample_dens > 0 and sa % isa_sample_dens == 0)
+        {
+            isa_sample[sa / isa_sample_dens] = i;
+        }
+    };
+    auto gen_bwt = [&](auto * A)
+    {
+        divbwt((uint8_t const *)text.data(), A, (std::remove_pointer_t<decltype(A)>)n, report);
+        for (size_type i = 0; i < n; ++i)
+        {
+            text[i] = A[i];
+        }
+    };
+    if (n < 0x7FFFFFFFULL)
+    {
+        std::vector<int32_t> A(n);
+        gen_bwt(A.data());
+    }
+    else
+    {
+        std::vector<int64_t> A(n);
+        gen_bwt(A.data());
+    }
+    store_to_cache(text, conf::KEY_BWT, config);
+    if (sa_sample_dens > 0)
+    {
+        store_to_cache(sa_sample, key_sa_sample(sa_sample_dens), config);
+    }
+    if (isa_sample_dens > 0)
+    {
+        store_to_cache(isa_sample, key_isa_sample(isa_sample_dens), config);
+    }
 }
 
 } // namespace sdsl
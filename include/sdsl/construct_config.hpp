@@ -5,6 +5,7 @@
 #define INCLUDED_SDSL_CONSTRUCT_CONFIG
 
 #include <sdsl/config.hpp>
+#include <sdsl/util.hpp>
 
 namespace sdsl
 {
@@ -12,6 +13,10 @@ namespace sdsl
 struct construct_config_data
 {
     byte_sa_algo_type byte_algo_sa = LIBDIVSUFSORT;
+    bool sa_free_bwt = true; // Construct the BWT of byte texts without the SA, if the index does not need the SA.
+    // Number of threads used by the parallel construction steps. The default of 1 keeps the construction
+    // sequential; set it to e.g. util::hardware_threads() to opt in.
+    uint64_t num_threads = 1;
 };
 
 extern inline construct_config_data & construct_config()
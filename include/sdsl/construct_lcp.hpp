@@ -20,6 +20,7 @@
 
 #include <sdsl/bits.hpp>
 #include <sdsl/config.hpp>
+#include <sdsl/construct_config.hpp>
 #include <sdsl/construct_isa.hpp>
 #include <sdsl/construct_lcp_helper.hpp>
 #include <sdsl/int_vector.hpp>
@@ -977,6 +978,52 @@ inline void construct_lcp_goPHI(cache_config & config)
     return;
 }
 
+//! Calculates the child intervals of a batch of intervals in the BWT.
+/*! For each interval [a,b) in `intervals` (stored as pairs a, b) and each symbol c occurring
+ *  in bwt[a..b-1] the interval [C[c]+rank(a,c), C[c]+rank(b,c)) is appended to `child_intervals`.
+ *  The wavelet tree queries are distributed over construct_config().num_threads threads;
+ *  the result is in the same order as in a sequential computation.
+ */
+template <class t_wt>
+void _lcp_bwt_child_intervals(t_wt const & wt_bwt,
+                              std::vector<int_vector<>::size_type> const & C,
+                              std::vector<int_vector<>::size_type> const & intervals,
+                              std::vector<int_vector<>::size_type> & child_intervals)
+{
+    typedef int_vector<>::size_type size_type;
+    size_type m = intervals.size() / 2;
+    size_type threads = std::max((size_type)1, std::min((size_type)construct_config().num_threads, m / 64));
+    size_type part = (m + threads - 1) / threads;
+    std::vector<std::vector<size_type>> res(threads);
+    util::run_parallel(threads,
+                       [&](uint64_t t)
+                       {
+                           size_type quantity;
+                           std::vector<unsigned char> cs(wt_bwt.sigma);
+                           std::vector<size_type> rank_c_i(wt_bwt.sigma);
+                           std::vector<size_type> rank_c_j(wt_bwt.sigma);
+                           size_type end = std::min(m, (t + 1) * part);
+                           for (size_type k = std::min(m, t * part); k < end; ++k)
+                           {
+                               interval_symbols(wt_bwt,
+                                                intervals[2 * k],
+                                                intervals[2 * k + 1],
+                                                quantity,
+                                                cs,
+                                                rank_c_i,
+                                                rank_c_j);
+                               for (size_type i = 0; i < quantity; ++i)
+                               {
+                                   res[t].push_back(C[cs[i]] + rank_c_i[i]);
+                                   res[t].push_back(C[cs[i]] + rank_c_j[i]);
+                               }
+                           }
+                       });
+    child_intervals.clear();
+    for (auto const & r : res)
+        child_intervals.insert(child_intervals.end(), r.begin(), r.end());
+}
+
 //! Construct the LCP array out of the BWT (only for byte strings)
 /*!	The algorithm computes the lcp array and stores it to disk. It needs only the Burrows and Wheeler transform.
  *  \param config	Reference to cache configuration
@@ -1026,6 +1073,10 @@ inline void construct_lcp_bwt_based(cache_config & config)
     std::vector<unsigned char> cs(wt_bwt.sigma);   // list of characters in the interval
     std::vector<size_type> rank_c_i(wt_bwt.sigma); // number of occurrence of character in [0 .. i-1]
     std::vector<size_type> rank_c_j(wt_bwt.sigma); // number of occurrence of character in [0 .. j-1]
+    // two entries per interval
+    size_type const batch_size = 2 * 4096 * std::max<uint64_t>(1, construct_config().num_threads);
+    std::vector<size_type> batch;           // intervals which are expanded in parallel
+    std::vector<size_type> child_intervals; // child intervals of the batch in sequential order
 
     // Calculate how many bit are for each lcp value available, to limit the memory usage to 20n bit = 2,5n byte, use at
     // moste 8 bit
@@ -1131,19 +1182,20 @@ inline void construct_lcp_bwt_based(cache_config & config)
             intervals_new = 0;
             while (intervals)
             {
-                // get next interval
-                size_type a = q.front();
-                q.pop();
-                size_type b = q.front();
-                q.pop();
-                --intervals;
-
-                interval_symbols(wt_bwt, a, b, quantity, cs, rank_c_i, rank_c_j);
-                for (size_type i = 0; i < quantity; ++i)
+                // get next intervals
+                batch.clear();
+                for (; intervals and batch.size() < batch_size; --intervals)
                 {
-                    unsigned char c = cs[i];
-                    size_type a_new = C[c] + rank_c_i[i];
-                    size_type b_new = C[c] + rank_c_j[i];
+                    batch.push_back(q.front());
+                    q.pop();
+                    batch.push_back(q.front());
+                    q.pop();
+                }
+                _lcp_bwt_child_intervals(wt_bwt, C, batch, child_intervals);
+                for (size_type i = 0; i < child_intervals.size(); i += 2)
+                {
+                    size_type a_new = child_intervals[i];
+                    size_type b_new = child_intervals[i + 1];
 
                     // Save LCP value if not seen before
                     if (!index_done[b_new] and phase == 0)
@@ -1182,12 +1234,20 @@ inline void construct_lcp_bwt_based(cache_config & config)
 
             while (b2 < dict[source].size())
             {
-                interval_symbols(wt_bwt, ((a2 - 1) >> 1), (b2 >> 1), quantity, cs, rank_c_i, rank_c_j);
-                for (size_type i = 0; i < quantity; ++i)
+                // get next intervals
+                batch.clear();
+                while (b2 < dict[source].size() and batch.size() < batch_size)
+                {
+                    batch.push_back((a2 - 1) >> 1);
+                    batch.push_back(b2 >> 1);
+                    a2 = util::next_bit(dict[source], b2 + 1);
+                    b2 = util::next_bit(dict[source], a2 + 1);
+                }
+                _lcp_bwt_child_intervals(wt_bwt, C, batch, child_intervals);
+                for (size_type i = 0; i < child_intervals.size(); i += 2)
                 {
-                    unsigned char c = cs[i];
-                    size_type a_new = C[c] + rank_c_i[i];
-                    size_type b_new = C[c] + rank_c_j[i];
+                    size_type a_new = child_intervals[i];
+                    size_type b_new = child_intervals[i + 1];
                     // Save LCP value if not seen before
                     if (!index_done[b_new] and phase == 0)
                     {
@@ -1211,9 +1271,6 @@ inline void construct_lcp_bwt_based(cache_config & config)
                         }
                     }
                 }
-                // get next interval
-                a2 = util::next_bit(dict[source], b2 + 1);
-                b2 = util::next_bit(dict[source], a2 + 1);
             }
             std::swap(source, target);
             util::set_to_value(dict[target], 0);
@@ -1321,6 +1378,10 @@ void construct_lcp_bwt_based2(cache_config & config)
         std::vector<unsigned char> cs(wt_bwt.sigma);   // list of characters in the interval
         std::vector<size_type> rank_c_i(wt_bwt.sigma); // number of occurrence of character in [0 .. i-1]
         std::vector<size_type> rank_c_j(wt_bwt.sigma); // number of occurrence of character in [0 .. j-1]
+        // two entries per interval
+        size_type const batch_size = 2 * 4096 * std::max<uint64_t>(1, construct_config().num_threads);
+        std::vector<size_type> batch;           // intervals which are expanded in parallel
+        std::vector<size_type> child_intervals; // child intervals of the batch in sequential order
 
         // External storage of LCP-Positions-Array
         bool new_lcp_value = false;
@@ -1421,19 +1482,20 @@ void construct_lcp_bwt_based2(cache_config & config)
                 intervals_new = 0;
                 while (intervals)
                 {
-                    // Get next interval
-                    size_type a = q.front();
-                    q.pop();
-                    size_type b = q.front();
-                    q.pop();
-                    --intervals;
-
-                    interval_symbols(wt_bwt, a, b, quantity, cs, rank_c_i, rank_c_j);
-                    for (size_type i = 0; i < quantity; ++i)
+                    // get next intervals
+                    batch.clear();
+                    for (; intervals and batch.size() < batch_size; --intervals)
+                    {
+                        batch.push_back(q.front());
+                        q.pop();
+                        batch.push_back(q.front());
+                        q.pop();
+                    }
+                    _lcp_bwt_child_intervals(wt_bwt, C, batch, child_intervals);
+                    for (size_type i = 0; i < child_intervals.size(); i += 2)
                     {
-                        unsigned char c = cs[i];
-                        size_type a_new = C[c] + rank_c_i[i];
-                        size_type b_new = C[c] + rank_c_j[i];
+                        size_type a_new = child_intervals[i];
+                        size_type b_new = child_intervals[i + 1];
 
                         // Save LCP value and corresponding interval if not seen before
                         if (!index_done[b_new])
@@ -1467,12 +1529,20 @@ void construct_lcp_bwt_based2(cache_config & config)
 
                 while (b2 < dict[source].size())
                 {
-                    interval_symbols(wt_bwt, ((a2 - 1) >> 1), (b2 >> 1), quantity, cs, rank_c_i, rank_c_j);
-                    for (size_type i = 0; i < quantity; ++i)
+                    // get next intervals
+                    batch.clear();
+                    while (b2 < dict[source].size() and batch.size() < batch_size)
                     {
-                        unsigned char c = cs[i];
-                        size_type a_new = C[c] + rank_c_i[i];
-                        size_type b_new = C[c] + rank_c_j[i];
+                        batch.push_back((a2 - 1) >> 1);
+                        batch.push_back(b2 >> 1);
+                        a2 = util::next_bit(dict[source], b2 + 1);
+                        b2 = util::next_bit(dict[source], a2 + 1);
+                    }
+                    _lcp_bwt_child_intervals(wt_bwt, C, batch, child_intervals);
+                    for (size_type i = 0; i < child_intervals.size(); i += 2)
+                    {
+                        size_type a_new = child_intervals[i];
+                        size_type b_new = child_intervals[i + 1];
                         // Save LCP value if not seen before
                         if (!index_done[b_new])
                         {
@@ -1491,9 +1561,6 @@ void construct_lcp_bwt_based2(cache_config & config)
                             ++intervals;
                         }
                     }
-                    // get next interval
-                    a2 = util::next_bit(dict[source], b2 + 1);
-                    b2 = util::next_bit(dict[source], a2 + 1);
                 }
                 std::swap(source, target);
                 util::set_to_value(dict[target], 0);
@@ -304,6 +304,13 @@ private:
         }
     }
 
+    // Calculates rank_bwt(i, c) and rank_bwt(j, c), i <= j.
+    std::pair<size_type, size_type> rank_bwt_pair(size_type i, size_type j, const char_type c) const
+    {
+        size_type rank_i = rank_bwt(i, c);
+        return {rank_i, i == j ? rank_i : rank_bwt(j, c)};
+    }
+
     // Calculates the i-th occurrence of symbol c in the BWT of the original text.
     /*
      *  \param i The i-th occurrence. \f$i\in [1..rank(size(),c)]\f$.
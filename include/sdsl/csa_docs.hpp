@@ -0,0 +1,437 @@
+// Copyright (c) 2016, the SDSL Project Authors.  All rights reserved.
+// Please see the AUTHORS file for details.  Use of this source code is governed
+// by a BSD license that can be found in the LICENSE file.
+/*!\file csa_docs.hpp
+ * \brief csa_docs.hpp contains a CSA over a document collection which maps occurrences to documents.
+ */
+#ifndef INCLUDED_SDSL_CSA_DOCS
+#define INCLUDED_SDSL_CSA_DOCS
+
+#include <algorithm>
+#include <iosfwd>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sdsl/bits.hpp>
+#include <sdsl/cereal.hpp>
+#include <sdsl/config.hpp>
+#include <sdsl/int_vector.hpp>
+#include <sdsl/io.hpp>
+#include <sdsl/rmq_succinct_sct.hpp>
+#include <sdsl/sd_vector.hpp>
+#include <sdsl/sdsl_concepts.hpp>
+#include <sdsl/structure_tree.hpp>
+#include <sdsl/suffix_array_algorithm.hpp>
+#include <sdsl/util.hpp>
+
+namespace sdsl
+{
+
+//! A CSA over a collection of documents.
+/*! The text is the concatenation of the documents, each terminated by the separator symbol t_sep.
+ *  In addition to the CSA the index stores
+ *    - the document starts in a bitvector of type t_bv (an sd_vector by default),
+ *    - the document array D, where D[i] is the document of suffix SA[i],
+ *    - a range minimum structure over the array C, where C[i]-1 is the largest j<i with D[j]=D[i]
+ *      (0 if there is no such j). C itself is only needed during the construction.
+ *  All members of t_csa are inherited. All structures are built during the construction of the CSA.
+ *
+ * \tparam t_csa CSA type.
+ * \tparam t_sep Symbol which terminates a document.
+ * \tparam t_bv  Bitvector type for the document starts.
+ *
+ * \par Space complexity
+ *      \f$ n\log d + 2n + o(n)\f$ bits in addition to the CSA, where \f$d\f$ is the number of documents.
+ * \par Reference
+ *      S. Muthukrishnan: Efficient algorithms for document retrieval problems. SODA 2002: 657-666 \n
+ *      Kunihiko Sadakane: Succinct data structures for flexible text retrieval systems. J. Discrete
+ *      Algorithms 5(1): 12-22 (2007)
+ * @ingroup csa
+ */
+template <class t_csa, uint64_t t_sep = 1, class t_bv = sd_vector<>>
+class csa_docs : public t_csa
+{
+public:
+    typedef typename t_csa::size_type size_type;
+    typedef t_bv bit_vector_type;
+    typedef typename t_bv::rank_1_type rank_1_type;
+    typedef typename t_bv::select_1_type select_1_type;
+    typedef rmq_succinct_sct<true> rmq_type;
+
+    enum
+    {
+        separator = t_sep
+    };
+
+private:
+    bit_vector_type m_doc_starts; // m_doc_starts[i]=1 iff a document starts at text position i
+    rank_1_type m_doc_starts_rank;
+    select_1_type m_doc_starts_select;
+    int_vector<> m_doc_array; // D[i] = document of SA[i]
+    rmq_type m_prev_rmq;      // RMQ over C[i] = 1 + largest j<i with D[j]=D[i], 0 if no such j exists
+
+    void set_support()
+    {
+        m_doc_starts_rank.set_vector(&m_doc_starts);
+        m_doc_starts_select.set_vector(&m_doc_starts);
+    }
+
+public:
+    bit_vector_type const & doc_starts = m_doc_starts;
+    int_vector<> const & doc_array = m_doc_array;
+
+    //! Default constructor
+    csa_docs() = default;
+
+    //! Copy constructor
+    csa_docs(csa_docs const & csa) :
+        t_csa(csa),
+        m_doc_starts(csa.m_doc_starts),
+        m_doc_starts_rank(csa.m_doc_starts_rank),
+        m_doc_starts_select(csa.m_doc_starts_select),
+        m_doc_array(csa.m_doc_array),
+        m_prev_rmq(csa.m_prev_rmq)
+    {
+        set_support();
+    }
+
+    //! Move constructor
+    csa_docs(csa_docs && csa) :
+        t_csa(std::move(csa)),
+        m_doc_starts(std::move(csa.m_doc_starts)),
+        m_doc_starts_rank(std::move(csa.m_doc_starts_rank)),
+        m_doc_starts_select(std::move(csa.m_doc_starts_select)),
+        m_doc_array(std::move(csa.m_doc_array)),
+        m_prev_rmq(std::move(csa.m_prev_rmq))
+    {
+        set_support();
+    }
+
+    //! Constructor taking a cache_config
+    /*! \pre The text exists in the cache (key conf::KEY_TEXT or conf::KEY_TEXT_INT) in addition to the
+     *       files which are required by t_csa(config).
+     */
+    csa_docs(cache_config & config) : t_csa(config)
+    {
+        constexpr uint8_t width = t_csa::alphabet_category::WIDTH;
+        size_type n = this->size();
+        if (n == 0)
+            return;
+        {
+            int_vector<width> text;
+            load_from_cache(text, key_text_trait<width>::KEY_TEXT, config);
+            bit_vector starts(n, 0);
+            starts[0] = 1;
+            for (size_type i = 0; i + 2 < n; ++i) // the sentinel belongs to the last document
+            {
+                if (text[i] == t_sep)
+                    starts[i + 1] = 1;
+            }
+            m_doc_starts = bit_vector_type(starts);
+        }
+        util::init_support(m_doc_starts_rank, &m_doc_starts);
+        util::init_support(m_doc_starts_select, &m_doc_starts);
+        size_type docs = m_doc_starts_rank(n);
+        // D is filled by a backward traversal of the text with LF, which does not require the SA
+        m_doc_array = int_vector<>(n, 0, bits::hi(docs) + 1);
+        size_type d = docs - 1, start = m_doc_starts_select(docs);
+        for (size_type pos = n, i = 0; pos > 0; --pos, i = this->lf[i])
+        {
+            while (pos - 1 < start)
+                start = m_doc_starts_select(d--);
+            m_doc_array[i] = d;
+        }
+        int_vector<> prev(n, 0, bits::hi(n) + 1);
+        {
+            int_vector<> last(docs, 0, bits::hi(n) + 1);
+            for (size_type i = 0; i < n; ++i)
+            {
+                prev[i] = last[m_doc_array[i]];
+                last[m_doc_array[i]] = i + 1;
+            }
+        }
+        m_prev_rmq = rmq_type(&prev);
+    }
+
+    //! Assignment Operator.
+    csa_docs & operator=(csa_docs const & csa)
+    {
+        if (this != &csa)
+        {
+            csa_docs tmp(csa);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    //! Assignment Move Operator.
+    csa_docs & operator=(csa_docs && csa)
+    {
+        if (this != &csa)
+        {
+            t_csa::operator=(std::move(csa));
+            m_doc_starts = std::move(csa.m_doc_starts);
+            m_doc_starts_rank = std::move(csa.m_doc_starts_rank);
+            m_doc_starts_select = std::move(csa.m_doc_starts_select);
+            m_doc_array = std::move(csa.m_doc_array);
+            m_prev_rmq = std::move(csa.m_prev_rmq);
+            set_support();
+        }
+        return *this;
+    }
+
+    //! Number of documents.
+    size_type docs() const
+    {
+        return this->empty() ? 0 : m_doc_starts_rank(this->size());
+    }
+
+    //! Document of text position i.
+    size_type doc(size_type i) const
+    {
+        return m_doc_starts_rank(i + 1) - 1;
+    }
+
+    //! Start position of document d in the text.
+    size_type doc_start(size_type d) const
+    {
+        return m_doc_starts_select(d + 1);
+    }
+
+    //! Maps sorted text positions to (document, offset in document) pairs.
+    /*!\param first Iterator to the first text position.
+     * \param last  Iterator past the last text position.
+     * \param out   Output iterator to which the pairs are written.
+     * \return The output iterator past the last written pair.
+     * \pre The text positions are sorted in ascending order.
+     * \par Time complexity
+     *      \f$ \Order{z + k\cdot t_{rank}} \f$, where \f$z\f$ is the number of positions and \f$k\f$ the number
+     *      of distinct documents, since only the first position of each document is ranked.
+     */
+    template <class t_pos_iter, class t_out_iter>
+    t_out_iter to_docs(t_pos_iter first, t_pos_iter last, t_out_iter out) const
+    {
+        size_type d = 0, start = 0, next_start = 0; // positions in [start, next_start) belong to d
+        for (; first != last; ++first, ++out)
+        {
+            size_type i = *first;
+            if (i >= next_start)
+            {
+                d = doc(i);
+                start = doc_start(d);
+                next_start = d + 1 < docs() ? doc_start(d + 1) : this->size();
+            }
+            *out = std::make_pair(d, i - start);
+        }
+        return out;
+    }
+
+    //! Lists the distinct documents of the suffixes in the SA interval [lb..rb].
+    /*! The interval is split recursively at the minimum of C, left part first. The document of a minimum
+     *  is reported unless it is already marked as reported; in that case all documents of the part were
+     *  reported before and the part is skipped. The marks are kept per thread and reset after the query.
+     * \param out Output iterator to which the documents are written.
+     * \return The output iterator past the last written document.
+     * \par Time complexity
+     *      \f$ \Order{k} \f$ RMQs, where \f$k\f$ is the number of distinct documents.
+     */
+    template <class t_out_iter>
+    t_out_iter list_docs(size_type lb, size_type rb, t_out_iter out) const
+    {
+        if (lb > rb)
+            return out;
+        thread_local bit_vector reported;
+        if (reported.size() < docs())
+            reported = bit_vector(docs(), 0);
+        std::vector<size_type> docs_found;
+        std::vector<std::pair<size_type, size_type>> stack{{lb, rb}};
+        while (!stack.empty())
+        {
+            auto iv = stack.back();
+            stack.pop_back();
+            size_type m = m_prev_rmq(iv.first, iv.second);
+            size_type d = m_doc_array[m];
+            if (reported[d]) // all documents of [iv.first..iv.second] were reported before
+                continue;
+            reported[d] = 1;
+            docs_found.push_back(d);
+            *out = d;
+            ++out;
+            if (m < iv.second)
+                stack.emplace_back(m + 1, iv.second);
+            if (m > iv.first) // the left part is processed first
+                stack.emplace_back(iv.first, m - 1);
+        }
+        for (size_type d : docs_found)
+            reported[d] = 0;
+        return out;
+    }
+
+    //! Serialize to a stream.
+    /*!\param out Output stream to write the data structure.
+     *  \return The number of written bytes.
+     */
+    size_type serialize(std::ostream & out, structure_tree_node * v = nullptr, std::string name = "") const
+    {
+        structure_tree_node * child = structure_tree::add_child(v, name, util::class_name(*this));
+        size_type written_bytes = 0;
+        written_bytes += t_csa::serialize(out, child, "csa");
+        written_bytes += m_doc_starts.serialize(out, child, "doc_starts");
+        written_bytes += m_doc_starts_rank.serialize(out, child, "doc_starts_rank");
+        written_bytes += m_doc_starts_select.serialize(out, child, "doc_starts_select");
+        written_bytes += m_doc_array.serialize(out, child, "doc_array");
+        written_bytes += m_prev_rmq.serialize(out, child, "prev_rmq");
+        structure_tree::add_size(child, written_bytes);
+        return written_bytes;
+    }
+
+    //! Load from a stream.
+    /*!\param in Input stream to load the data structure from.
+     */
+    void load(std::istream & in)
+    {
+        t_csa::load(in);
+        m_doc_starts.load(in);
+        m_doc_starts_rank.load(in, &m_doc_starts);
+        m_doc_starts_select.load(in, &m_doc_starts);
+        m_doc_array.load(in);
+        m_prev_rmq.load(in);
+    }
+
+    template <typename archive_t>
+    void CEREAL_SAVE_FUNCTION_NAME(archive_t & ar) const
+    {
+        t_csa::CEREAL_SAVE_FUNCTION_NAME(ar);
+        ar(CEREAL_NVP(m_doc_starts));
+        ar(CEREAL_NVP(m_doc_starts_rank));
+        ar(CEREAL_NVP(m_doc_starts_select));
+        ar(CEREAL_NVP(m_doc_array));
+        ar(CEREAL_NVP(m_prev_rmq));
+    }
+
+    template <typename archive_t>
+    void CEREAL_LOAD_FUNCTION_NAME(archive_t & ar)
+    {
+        t_csa::CEREAL_LOAD_FUNCTION_NAME(ar);
+        ar(CEREAL_NVP(m_doc_starts));
+        ar(CEREAL_NVP(m_doc_starts_rank));
+        ar(CEREAL_NVP(m_doc_starts_select));
+        ar(CEREAL_NVP(m_doc_array));
+        ar(CEREAL_NVP(m_prev_rmq));
+        set_support();
+    }
+
+    //! Equality operator.
+    bool operator==(csa_docs const & other) const noexcept
+    {
+        return t_csa::operator==(other) && (m_doc_starts == other.m_doc_starts)
+            && (m_doc_array == other.m_doc_array) && (m_prev_rmq == other.m_prev_rmq);
+    }
+
+    //! Inequality operator.
+    bool operator!=(csa_docs const & other) const noexcept
+    {
+        return !(*this == other);
+    }
+};
+
+//! Calculates all occurrences of a pattern in a csa_docs as (document, offset) pairs.
+/*!
+ * \param csa   The csa_docs object.
+ * \param begin Iterator to the begin of the pattern (inclusive).
+ * \param end   Iterator to the end of the pattern (exclusive).
+ * \return The (document, offset in document) pairs of all occurrences in text order.
+ *
+ * \par Time complexity
+ *        \f$ \Order{ t_{backward\_search} + z \cdot t_{SA} + z\log z + k \cdot t_{rank}} \f$, where \f$z\f$ is the
+ *        number of occurrences and \f$k\f$ the number of distinct documents.
+ */
+template <class t_csa, uint64_t t_sep, class t_bv, class t_pat_iter>
+std::vector<std::pair<uint64_t, uint64_t>> locate_docs(csa_docs<t_csa, t_sep, t_bv> const & csa,
+                                                       t_pat_iter begin,
+                                                       t_pat_iter end)
+{
+    auto occ = locate(csa, begin, end);
+    std::sort(occ.begin(), occ.end());
+    std::vector<std::pair<uint64_t, uint64_t>> res(occ.size());
+    csa.to_docs(occ.begin(), occ.end(), res.begin());
+    return res;
+}
+
+//! Calculates all occurrences of a pattern pat in a csa_docs as (document, offset) pairs.
+template <class t_csa, uint64_t t_sep, class t_bv>
+std::vector<std::pair<uint64_t, uint64_t>> locate_docs(csa_docs<t_csa, t_sep, t_bv> const & csa,
+                                                       typename t_csa::string_type const & pat)
+{
+    return locate_docs(csa, pat.begin(), pat.end());
+}
+
+//! Lists the documents which contain a pattern.
+/*!
+ * \param csa   The csa_docs object.
+ * \param begin Iterator to the begin of the pattern (inclusive).
+ * \param end   Iterator to the end of the pattern (exclusive).
+ * \return The sorted list of documents which contain the pattern.
+ *
+ * \par Time complexity
+ *        \f$ \Order{ t_{backward\_search} + k\log k } \f$, where \f$k\f$ is the number of documents.
+ */
+template <class t_csa, uint64_t t_sep, class t_bv, class t_pat_iter>
+std::vector<uint64_t> list_docs(csa_docs<t_csa, t_sep, t_bv> const & csa, t_pat_iter begin, t_pat_iter end)
+{
+    std::vector<uint64_t> res;
+    typename t_csa::size_type lb = 0, rb = 0;
+    if (backward_search(csa, 0, csa.size() - 1, begin, end, lb, rb) > 0)
+        csa.list_docs(lb, rb, std::back_inserter(res));
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+//! Counts the documents which contain a pattern.
+/*!
+ * \param csa   The csa_docs object.
+ * \param begin Iterator to the begin of the pattern (inclusive).
+ * \param end   Iterator to the end of the pattern (exclusive).
+ * \return The number of documents which contain the pattern.
+ *
+ * \par Time complexity
+ *        \f$ \Order{ t_{backward\_search} + k } \f$, where \f$k\f$ is the result.
+ */
+template <class t_csa, uint64_t t_sep, class t_bv, class t_pat_iter>
+uint64_t count_docs(csa_docs<t_csa, t_sep, t_bv> const & csa, t_pat_iter begin, t_pat_iter end)
+{
+    struct counter
+    {
+        uint64_t cnt = 0;
+        counter & operator*()
+        {
+            return *this;
+        }
+        counter & operator++()
+        {
+            return *this;
+        }
+        counter & operator=(uint64_t)
+        {
+            ++cnt;
+            return *this;
+        }
+    };
+    typename t_csa::size_type lb = 0, rb = 0;
+    if (backward_search(csa, 0, csa.size() - 1, begin, end, lb, rb) == 0)
+        return 0;
+    return csa.list_docs(lb, rb, counter()).cnt;
+}
+
+//! Counts the documents which contain a pattern pat.
+template <class t_csa, uint64_t t_sep, class t_bv>
+uint64_t count_docs(csa_docs<t_csa, t_sep, t_bv> const & csa, typename t_csa::string_type const & pat)
+{
+    return count_docs(csa, pat.begin(), pat.end());
+}
+
+} // end namespace sdsl
+
+#endif
@@ -115,16 +115,6 @@ private:
     isa_sample_type m_isa_sample; // inverse suffix array samples
     alphabet_type m_alphabet;     // alphabet component
 
-    mutable std::vector<uint64_t> m_psi_buf; // buffer for decoded psi values
-
-    void create_buffer()
-    {
-        if (enc_vector_type::sample_dens < linear_decode_limit)
-        {
-            m_psi_buf = std::vector<uint64_t>(enc_vector_type::sample_dens + 1);
-        }
-    }
-
 public:
     const typename alphabet_type::char2comp_type & char2comp = m_alphabet.char2comp;
     const typename alphabet_type::comp2char_type & comp2char = m_alphabet.comp2char;
@@ -142,9 +132,7 @@ public:
 
     //! Default Constructor
     csa_sada()
-    {
-        create_buffer();
-    }
+    {}
     //! Default Destructor
     ~csa_sada()
     {}
@@ -156,7 +144,6 @@ public:
         m_isa_sample(csa.m_isa_sample),
         m_alphabet(csa.m_alphabet)
     {
-        create_buffer();
         m_isa_sample.set_vector(&m_sa_sample);
     }
 
@@ -167,7 +154,6 @@ public:
         m_isa_sample(std::move(csa.m_isa_sample)),
         m_alphabet(std::move(csa.m_alphabet))
     {
-        create_buffer();
         m_isa_sample.set_vector(&m_sa_sample);
     }
 
@@ -256,7 +242,6 @@ public:
             m_isa_sample = std::move(csa.m_isa_sample);
             m_isa_sample.set_vector(&m_sa_sample);
             m_alphabet = std::move(csa.m_alphabet);
-            m_psi_buf = std::move(csa.m_psi_buf);
         }
         return *this;
     }
@@ -338,26 +323,29 @@ private:
             // TODO: don't use get_inter_sampled_values if t_dens is really
             //       large
             lower_b = lower_sb * sd;
-            if (0 == m_psi_buf.size())
+            if (enc_vector_type::sample_dens >= linear_decode_limit)
             {
                 upper_b = std::min(upper_sb * sd, C[cc + 1]);
                 goto finish;
             }
-            uint64_t * p = m_psi_buf.data();
+            // buffer for decoded psi values; one per thread, so that concurrent queries do not interfere
+            thread_local std::vector<uint64_t> psi_buf;
+            psi_buf.resize(enc_vector_type::sample_dens + 1);
+            uint64_t * p = psi_buf.data();
             // extract the psi values between two samples
             m_psi.get_inter_sampled_values(lower_sb, p);
-            p = m_psi_buf.data();
+            p = psi_buf.data();
             uint64_t smpl = m_psi.sample(lower_sb);
             // handle border cases
             if (lower_b + m_psi.get_sample_dens() >= C[cc + 1])
-                m_psi_buf[C[cc + 1] - lower_b] = size() - smpl;
+                psi_buf[C[cc + 1] - lower_b] = size() - smpl;
             else
-                m_psi_buf[m_psi.get_sample_dens()] = size() - smpl;
+                psi_buf[m_psi.get_sample_dens()] = size() - smpl;
             // search the result linear
             while ((*p++) + smpl < i)
                 ;
 
-            return p - 1 - m_psi_buf.data() + lower_b - C[cc];
+            return p - 1 - psi_buf.data() + lower_b - C[cc];
         }
         else
         { // lower_b == (m_C[cc]+sd-1)/sd and lower_sb < upper_sb
@@ -391,6 +379,13 @@ private:
         }
     }
 
+    // Calculates rank_bwt(i, c) and rank_bwt(j, c), i <= j.
+    std::pair<size_type, size_type> rank_bwt_pair(size_type i, size_type j, const char_type c) const
+    {
+        size_type rank_i = rank_bwt(i, c);
+        return {rank_i, i == j ? rank_i : rank_bwt(j, c)};
+    }
+
     // Calculates the position of the i-th c in the BWT of the original text.
     /*
      *  \param i The i-th occurrence. \f$i\in [1..rank_bwt(size(),c)]\f$.
@@ -425,7 +420,6 @@ template <class t_enc_vec,
           class t_alphabet_strat>
 csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::csa_sada(cache_config & config)
 {
-    create_buffer();
     if (!cache_file_exists(key_bwt<alphabet_type::int_width>(), config))
     {
         return;
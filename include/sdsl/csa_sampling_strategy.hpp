@@ -37,6 +37,7 @@
  * [1] P.Ferragina, J. Siren, R. Venturini: Distribution-Aware Compressed Full-Text Indexes, ESA 2011
  */
 
+#include <algorithm>
 #include <iosfwd>
 #include <set>
 #include <stdint.h>
@@ -83,6 +84,10 @@ public:
     {
         text_order = false
     };
+    enum
+    {
+        cached_samples = true
+    };
     typedef sa_sampling_tag sampling_category;
 
     //! Default constructor
@@ -91,13 +96,22 @@ public:
 
     //! Constructor
     /*
-     * \param cconfig Cache configuration (SA is expected to be cached.).
+     * \param cconfig Cache configuration (SA or the samples key_sa_sample(sample_dens) are expected to be cached.).
      * \param csa     Pointer to the corresponding CSA. Not used in this class.
      * \par Time complexity
      *      Linear in the size of the suffix array.
      */
     _sa_order_sampling(cache_config const & cconfig, SDSL_UNUSED t_csa const * csa = nullptr)
     {
+        if (cache_file_exists(key_sa_sample(sample_dens), cconfig))
+        {
+            int_vector<> samples;
+            load_from_cache(samples, key_sa_sample(sample_dens), cconfig);
+            this->width(samples.width());
+            this->resize(samples.size());
+            std::copy(samples.begin(), samples.end(), this->begin());
+            return;
+        }
         int_vector_buffer<> sa_buf(cache_file_name(conf::KEY_SA, cconfig));
         size_type n = sa_buf.size();
         this->width(bits::hi(n) + 1);
@@ -745,6 +759,10 @@ public:
     {
         sample_dens = t_csa::isa_sample_dens
     };
+    enum
+    {
+        cached_samples = true
+    };
     typedef isa_sampling_tag sampling_category;
 
     //! Default constructor
@@ -753,13 +771,22 @@ public:
 
     //! Constructor
     /*
-     * \param cconfig   Cache configuration (SA is expected to be cached.).
+     * \param cconfig   Cache configuration (SA or the samples key_isa_sample(sample_dens) are expected to be cached.).
      * \param sa_sample Pointer to the corresponding SA sampling. Not used in this class.
      * \par Time complexity
      *      Linear in the size of the suffix array.
      */
     _isa_sampling(cache_config const & cconfig, SDSL_UNUSED sa_type const * sa_sample = nullptr)
     {
+        if (cache_file_exists(key_isa_sample(sample_dens), cconfig))
+        {
+            int_vector<> samples;
+            load_from_cache(samples, key_isa_sample(sample_dens), cconfig);
+            this->width(samples.width());
+            this->resize(samples.size());
+            std::copy(samples.begin(), samples.end(), this->begin());
+            return;
+        }
         int_vector_buffer<> sa_buf(cache_file_name(conf::KEY_SA, cconfig));
         size_type n = sa_buf.size();
         if (n >= 1)
@@ -0,0 +1,151 @@
+// Copyright (c) 2016, the SDSL Project Authors.  All rights reserved.
+// Please see the AUTHORS file for details.  Use of this source code is governed
+// by a BSD license that can be found in the LICENSE file.
+/*!\file csa_text.hpp
+ * \brief csa_text.hpp contains a CSA which is combined with a plain text accessor for fast extraction.
+ */
+#ifndef INCLUDED_SDSL_CSA_TEXT
+#define INCLUDED_SDSL_CSA_TEXT
+
+#include <iosfwd>
+#include <string>
+#include <utility>
+
+#include <sdsl/block_text.hpp>
+#include <sdsl/cereal.hpp>
+#include <sdsl/config.hpp>
+#include <sdsl/int_vector.hpp>
+#include <sdsl/io.hpp>
+#include <sdsl/sdsl_concepts.hpp>
+#include <sdsl/structure_tree.hpp>
+#include <sdsl/util.hpp>
+
+namespace sdsl
+{
+
+//! A CSA combined with a plain text accessor.
+/*! All operations of the CSA (count, locate, SA, ISA, Psi, LF, ...) are inherited from t_csa.
+ *  extract is answered by the text store, which decodes the text directly instead of
+ *  performing one LF or Psi step per symbol. The text store is built from the text in the cache
+ *  during the construction of the CSA.
+ *
+ * \tparam t_csa        CSA type.
+ * \tparam t_text_store Random access text representation with a method extract(begin, end, text_iter),
+ *                      e.g. block_text.
+ *
+ * \par Time complexity
+ *      extract of \f$\ell\f$ symbols takes \f$\Order{\ell}\f$ time for block_text.
+ * @ingroup csa
+ */
+template <class t_csa, class t_text_store = block_text<>>
+class csa_text : public t_csa
+{
+public:
+    typedef typename t_csa::size_type size_type;
+    typedef t_text_store text_store_type;
+    typedef text_tag extract_category;
+
+private:
+    text_store_type m_text_store;
+
+public:
+    text_store_type const & text_store = m_text_store;
+
+    //! Default constructor
+    csa_text() = default;
+
+    //! Copy constructor
+    csa_text(csa_text const & csa) : t_csa(csa), m_text_store(csa.m_text_store)
+    {}
+
+    //! Move constructor
+    csa_text(csa_text && csa) : t_csa(std::move(csa)), m_text_store(std::move(csa.m_text_store))
+    {}
+
+    //! Constructor taking a cache_config
+    /*! Builds the CSA and the text store.
+     *  \pre The text exists in the cache (key conf::KEY_TEXT or conf::KEY_TEXT_INT) in addition to the
+     *       files which are required by t_csa(config).
+     */
+    csa_text(cache_config & config) : t_csa(config)
+    {
+        int_vector<t_csa::alphabet_category::WIDTH> text;
+        load_from_cache(text, key_text_trait<t_csa::alphabet_category::WIDTH>::KEY_TEXT, config);
+        m_text_store = text_store_type(text.begin(), text.end());
+    }
+
+    //! Assignment Operator.
+    csa_text & operator=(csa_text const & csa)
+    {
+        if (this != &csa)
+        {
+            csa_text tmp(csa);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    //! Assignment Move Operator.
+    csa_text & operator=(csa_text && csa)
+    {
+        if (this != &csa)
+        {
+            t_csa::operator=(std::move(csa));
+            m_text_store = std::move(csa.m_text_store);
+        }
+        return *this;
+    }
+
+    //! Equality operator.
+    bool operator==(csa_text const & other) const noexcept
+    {
+        return t_csa::operator==(other) && (m_text_store == other.m_text_store);
+    }
+
+    //! Inequality operator.
+    bool operator!=(csa_text const & other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    //! Serialize to a stream.
+    /*!\param out Output stream to write the data structure.
+     *  \return The number of written bytes.
+     */
+    size_type serialize(std::ostream & out, structure_tree_node * v = nullptr, std::string name = "") const
+    {
+        structure_tree_node * child = structure_tree::add_child(v, name, util::class_name(*this));
+        size_type written_bytes = 0;
+        written_bytes += t_csa::serialize(out, child, "csa");
+        written_bytes += m_text_store.serialize(out, child, "text_store");
+        structure_tree::add_size(child, written_bytes);
+        return written_bytes;
+    }
+
+    //! Load from a stream.
+    /*!\param in Input stream to load the data structure from.
+     */
+    void load(std::istream & in)
+    {
+        t_csa::load(in);
+        m_text_store.load(in);
+    }
+
+    template <typename archive_t>
+    void CEREAL_SAVE_FUNCTION_NAME(archive_t & ar) const
+    {
+        t_csa::CEREAL_SAVE_FUNCTION_NAME(ar);
+        ar(CEREAL_NVP(m_text_store));
+    }
+
+    template <typename archive_t>
+    void CEREAL_LOAD_FUNCTION_NAME(archive_t & ar)
+    {
+        t_csa::CEREAL_LOAD_FUNCTION_NAME(ar);
+        ar(CEREAL_NVP(m_text_store));
+    }
+};
+
+} // end namespace sdsl
+
+#endif
@@ -19,6 +19,7 @@
 #include <sdsl/config.hpp>
 #include <sdsl/csa_alphabet_strategy.hpp>
 #include <sdsl/csa_sampling_strategy.hpp>
+#include <sdsl/fast_cache.hpp>
 #include <sdsl/int_vector.hpp>
 #include <sdsl/int_vector_buffer.hpp>
 #include <sdsl/io.hpp>
@@ -108,10 +109,7 @@ private:
     sa_sample_type m_sa_sample;   // suffix array samples
     isa_sample_type m_isa_sample; // inverse suffix array samples
     alphabet_type m_alphabet;
-//#define USE_CSA_CACHE
-#ifdef USE_CSA_CACHE
-    mutable fast_cache csa_cache;
-#endif
+    query_cache_id m_cache_id;    // identifies the SA values in the query cache, see query_cache_config
 
 public:
     const typename alphabet_type::char2comp_type & char2comp = m_alphabet.char2comp;
@@ -238,6 +236,7 @@ public:
             m_isa_sample = std::move(csa.m_isa_sample);
             m_isa_sample.set_vector(&m_sa_sample);
             m_alphabet = std::move(csa.m_alphabet);
+            m_cache_id.renew();
         }
         return *this;
     }
@@ -288,6 +287,12 @@ private:
         return m_wavelet_tree.rank(i, c);
     }
 
+    // Calculates rank_bwt(i, c) and rank_bwt(j, c) with one descent of the wavelet tree, i <= j.
+    std::pair<size_type, size_type> rank_bwt_pair(size_type i, size_type j, const char_type c) const
+    {
+        return m_wavelet_tree.rank_pair(i, j, c);
+    }
+
     // Calculates the position of the i-th c in the BWT of the original text.
     /*
      *  \param i The i-th occurrence. \f$i\in [1..rank(size(),c)]\f$.
@@ -363,21 +368,27 @@ template <class t_wt,
 inline auto csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::operator[](size_type i) const
     -> value_type
 {
-    size_type off = 0;
-    while (!m_sa_sample.is_sampled(i))
-    {
-        i = lf[i];
-        ++off;
-    }
-    value_type result = m_sa_sample[i];
-    if (result + off < size())
-    {
-        return result + off;
-    }
-    else
-    {
-        return result + off - size();
-    }
+    return cached_query(query_cache_kind::sa,
+                        m_cache_id,
+                        i,
+                        [this, i]() mutable -> size_type
+                        {
+                            size_type off = 0;
+                            while (!m_sa_sample.is_sampled(i))
+                            {
+                                i = lf[i];
+                                ++off;
+                            }
+                            value_type result = m_sa_sample[i];
+                            if (result + off < size())
+                            {
+                                return result + off;
+                            }
+                            else
+                            {
+                                return result + off - size();
+                            }
+                        });
 }
 
 template <class t_wt,
@@ -413,6 +424,7 @@ void csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat
     m_sa_sample.load(in);
     m_isa_sample.load(in, &m_sa_sample);
     m_alphabet.load(in);
+    m_cache_id.renew();
 }
 
 template <class t_wt,
@@ -446,6 +458,7 @@ void csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat
     ar(CEREAL_NVP(m_isa_sample));
     m_isa_sample.set_vector(&m_sa_sample);
     ar(CEREAL_NVP(m_alphabet));
+    m_cache_id.renew();
 }
 
 } // end namespace sdsl
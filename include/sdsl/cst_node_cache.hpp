@@ -0,0 +1,307 @@
+// Copyright (c) 2016, the SDSL Project Authors.  All rights reserved.
+// Please see the AUTHORS file for details.  Use of this source code is governed
+// by a BSD license that can be found in the LICENSE file.
+/*!\file cst_node_cache.hpp
+ * \brief cst_node_cache.hpp contains a memo for the navigation operations of (compressed) suffix trees.
+ */
+#ifndef INCLUDED_SDSL_CST_NODE_CACHE
+#define INCLUDED_SDSL_CST_NODE_CACHE
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace sdsl
+{
+
+//! A memo of recently visited nodes of a (compressed) suffix tree.
+/*! Tree walking algorithms like matching statistics call depth(v), sl(v), wl(v,c) and child(v,c) many
+ *  times for the same inner nodes. The cache stores the results of these operations in two 2-way set
+ *  associative tables with least-recently-used replacement. A node is identified by its interval
+ *  [lb(v),rb(v)], so the cache can be used with every CST of the library.
+ *
+ *  The cache belongs to the caller and is not shared between threads: each thread uses its own
+ *  cst_node_cache object on the same (const) CST.
+ *
+ * \tparam t_cst Type of the CST.
+ *
+ * \par Space complexity
+ *   \f$ 2^{log\_sets+1}\f$ entries in each of the two tables.
+ */
+template <class t_cst>
+class cst_node_cache
+{
+public:
+    typedef typename t_cst::size_type size_type;
+    typedef typename t_cst::node_type node_type;
+    typedef typename t_cst::char_type char_type;
+
+private:
+    struct node_entry
+    {
+        size_type lb = 1, rb = 0; // lb > rb marks an empty entry
+        size_type depth = 0;
+        bool has_depth = false;
+        bool has_sl = false;
+        node_type sl;
+    };
+
+    struct link_entry
+    {
+        size_type lb = 1, rb = 0; // lb > rb marks an empty entry
+        uint64_t tag = 0;         // (c << 1) | is_wl
+        node_type w;
+    };
+
+    t_cst const * m_cst = nullptr;
+    uint64_t m_mask = 0;
+    std::vector<node_entry> m_nodes; // way 0 of set s at 2s, way 1 at 2s+1; way 0 is the most recently used
+    std::vector<link_entry> m_links;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+
+    uint64_t set_of(size_type lb, size_type rb, uint64_t tag) const
+    {
+        uint64_t h = (lb * 0x9E3779B97F4A7C15ULL) ^ (rb * 0xC2B2AE3D27D4EB4FULL) ^ (tag * 0x165667B19E3779F9ULL);
+        return (h ^ (h >> 29)) & m_mask;
+    }
+
+    // Returns the entry of (lb,rb[,tag]) in the table, moved to way 0 of its set.
+    // If the node is not cached, the least recently used entry of the set is replaced by an empty one.
+    template <class t_entry, class t_eq>
+    t_entry & find(std::vector<t_entry> & table, size_type lb, size_type rb, uint64_t tag, t_eq eq, bool & found)
+    {
+        t_entry * e = &table[set_of(lb, rb, tag) << 1];
+        found = true;
+        if (eq(e[0]))
+            return e[0];
+        std::swap(e[0], e[1]);
+        if (eq(e[0]))
+            return e[0];
+        found = false;
+        e[0] = t_entry();
+        e[0].lb = lb;
+        e[0].rb = rb;
+        return e[0];
+    }
+
+    node_entry & find_node(node_type const & v, bool & found)
+    {
+        size_type lb = m_cst->lb(v), rb = m_cst->rb(v);
+        return find(
+            m_nodes,
+            lb,
+            rb,
+            0,
+            [&](node_entry const & e)
+            {
+                return e.lb == lb and e.rb == rb;
+            },
+            found);
+    }
+
+    // Returns the entry of the link (v,c,is_wl). On a miss the entry is empty and found is false.
+    link_entry & find_link(node_type const & v, char_type c, bool is_wl, bool & found)
+    {
+        size_type lb = m_cst->lb(v), rb = m_cst->rb(v);
+        uint64_t tag = ((uint64_t)c << 1) | is_wl;
+        link_entry & e = find(
+            m_links,
+            lb,
+            rb,
+            tag,
+            [&](link_entry const & x)
+            {
+                return x.lb == lb and x.rb == rb and x.tag == tag;
+            },
+            found);
+        e.tag = tag;
+        return e;
+    }
+
+    node_type link(node_type const & v, char_type c, bool is_wl)
+    {
+        bool found;
+        link_entry & e = find_link(v, c, is_wl, found);
+        if (found)
+        {
+            ++m_hits;
+        }
+        else
+        {
+            ++m_misses;
+            e.w = is_wl ? m_cst->wl(v, c) : m_cst->child(v, c);
+        }
+        return e.w;
+    }
+
+public:
+    cst_node_cache() = default;
+
+    //! Constructor
+    /*!\param cst      The CST whose operations are cached.
+     * \param log_sets Logarithm of the number of sets in each table.
+     */
+    cst_node_cache(t_cst const & cst, uint8_t log_sets = 12) :
+        m_cst(&cst),
+        m_mask((1ULL << log_sets) - 1),
+        m_nodes(2ULL << log_sets),
+        m_links(2ULL << log_sets)
+    {}
+
+    //! Returns the string depth of node v, see t_cst::depth.
+    size_type depth(node_type const & v)
+    {
+        bool found;
+        node_entry & e = find_node(v, found);
+        if (e.has_depth)
+        {
+            ++m_hits;
+        }
+        else
+        {
+            ++m_misses;
+            e.depth = m_cst->depth(v);
+            e.has_depth = true;
+        }
+        return e.depth;
+    }
+
+    //! Returns the suffix link of node v, see t_cst::sl.
+    node_type sl(node_type const & v)
+    {
+        bool found;
+        node_entry & e = find_node(v, found);
+        if (e.has_sl)
+        {
+            ++m_hits;
+        }
+        else
+        {
+            ++m_misses;
+            e.sl = m_cst->sl(v);
+            e.has_sl = true;
+        }
+        return e.sl;
+    }
+
+    //! Returns the Weiner link of node v and character c, see t_cst::wl.
+    node_type wl(node_type const & v, char_type c)
+    {
+        return link(v, c, true);
+    }
+
+    //! Returns the child of node v whose edge label starts with c, see t_cst::child.
+    node_type child(node_type const & v, char_type c)
+    {
+        return link(v, c, false);
+    }
+
+    //! Batched child operation.
+    /*!\param v_first Iterator to the first node.
+     * \param v_last  Iterator past the last node.
+     * \param c_first Iterator to the character of the first node.
+     * \param out     Output iterator to which child(v,c) is written for each pair (v,c), in input order.
+     * \return The output iterator past the last written node.
+     *
+     * The requests are grouped by node. If a node has more than one request which is not cached, its
+     * children are enumerated once and all its requests are answered from this enumeration instead of
+     * one t_cst::child call per request.
+     */
+    template <class t_node_it, class t_char_it, class t_out_it>
+    t_out_it child(t_node_it v_first, t_node_it v_last, t_char_it c_first, t_out_it out)
+    {
+        std::vector<std::pair<node_type, char_type>> req;
+        std::vector<std::pair<size_type, size_type>> key; // interval of the node of each request
+        for (; v_first != v_last; ++v_first, ++c_first)
+        {
+            req.emplace_back(*v_first, *c_first);
+            key.emplace_back(m_cst->lb(*v_first), m_cst->rb(*v_first));
+        }
+        std::vector<size_type> order(req.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(),
+                         order.end(),
+                         [&](size_type i, size_type j)
+                         {
+                             return key[i] < key[j];
+                         });
+        std::vector<node_type> res(req.size());
+        std::vector<std::pair<char_type, node_type>> children; // children of the current node, sorted by edge
+        for (size_type g = 0, h = 0; g < order.size(); g = h)
+        {
+            while (h < order.size() and key[order[h]] == key[order[g]])
+                ++h;
+            node_type const & v = req[order[g]].first;
+            bool enumerated = false;
+            for (size_type k = g; k < h; ++k)
+            {
+                size_type i = order[k];
+                bool found;
+                link_entry & e = find_link(v, req[i].second, false, found);
+                if (found)
+                {
+                    ++m_hits;
+                }
+                else if (enumerated or k + 1 < h)
+                {
+                    ++m_misses;
+                    if (!enumerated)
+                    {
+                        children.clear();
+                        if (!m_cst->is_leaf(v))
+                        {
+                            size_type d = depth(v);
+                            for (node_type w = m_cst->select_child(v, 1); w != m_cst->root(); w = m_cst->sibling(w))
+                                children.emplace_back(m_cst->edge(w, d + 1), w);
+                        }
+                        enumerated = true;
+                    }
+                    auto it = std::lower_bound(children.begin(),
+                                               children.end(),
+                                               req[i].second,
+                                               [](std::pair<char_type, node_type> const & x, char_type c)
+                                               {
+                                                   return x.first < c;
+                                               });
+                    e.w = (it != children.end() and it->first == req[i].second) ? it->second : m_cst->root();
+                }
+                else
+                {
+                    ++m_misses;
+                    e.w = m_cst->child(v, req[i].second);
+                }
+                res[i] = e.w;
+            }
+        }
+        return std::copy(res.begin(), res.end(), out);
+    }
+
+    //! Removes all entries and resets the statistics.
+    void clear()
+    {
+        for (auto & e : m_nodes)
+            e = node_entry();
+        for (auto & e : m_links)
+            e = link_entry();
+        m_hits = m_misses = 0;
+    }
+
+    //! Number of operations which were answered from the cache.
+    uint64_t hits() const
+    {
+        return m_hits;
+    }
+
+    //! Number of operations which were forwarded to the CST.
+    uint64_t misses() const
+    {
+        return m_misses;
+    }
+};
+
+} // end namespace sdsl
+
+#endif
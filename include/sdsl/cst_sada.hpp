@@ -830,8 +830,9 @@ public:
         // get the rightmost leaf in the tree rooted at v
         size_type right = is_leaf(v) ? left : m_bp_rank10(m_bp_support.find_close(v)) - 1;
 
-        size_type c_left = m_csa.bwt.rank(left, c);
-        size_type c_right = m_csa.bwt.rank(right + 1, c);
+        auto ranks = m_csa.bwt.rank_pair(left, right + 1, c);
+        size_type c_left = ranks.first;
+        size_type c_right = ranks.second;
 
         if (c_left == c_right) // there exists no Weiner link
             return root();
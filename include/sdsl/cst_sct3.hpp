@@ -1083,8 +1083,9 @@ public:
      */
     node_type wl(node_type const & v, const char_type c) const
     {
-        size_type c_left = m_csa.bwt.rank(v.i, c);
-        size_type c_right = m_csa.bwt.rank(v.j + 1, c);
+        auto ranks = m_csa.bwt.rank_pair(v.i, v.j + 1, c);
+        size_type c_left = ranks.first;
+        size_type c_right = ranks.second;
         if (c_left == c_right) // there exists no Weiner link
             return root();
         if (c_left + 1 == c_right)
@@ -2355,10 +2355,17 @@ inline void construct_SA(uint8_t const * T, saidx_t * SA, saidx_t * bucket_A, sa
 }
 
 /* Constructs the burrows-wheeler transformed string directly
-   by using the sorted order of type B* suffixes. */
-template <typename saidx_t>
-inline saidx_t
-construct_BWT(uint8_t const * T, saidx_t * SA, saidx_t * bucket_A, saidx_t * bucket_B, saidx_t n, saidx_t m)
+   by using the sorted order of type B* suffixes.
+   report(i, s) is called exactly once for each slot i of the suffix array
+   with the suffix s = SA[i], at the time the value is known. */
+template <typename saidx_t, typename t_report>
+inline saidx_t construct_BWT(uint8_t const * T,
+                             saidx_t * SA,
+                             saidx_t * bucket_A,
+                             saidx_t * bucket_B,
+                             saidx_t n,
+                             saidx_t m,
+                             t_report && report)
 {
     saidx_t *i, *j, *k, *orig;
     saidx_t s;
@@ -2378,6 +2385,7 @@ construct_BWT(uint8_t const * T, saidx_t * SA, saidx_t * bucket_A, saidx_t * buc
                     assert(T[s] == c1);
                     assert(((s + 1) < n) && (T[s] <= T[s + 1]));
                     assert(T[s - 1] <= T[s]);
+                    report(j - SA, s);
                     c0 = T[--s];
                     *j = ~((saidx_t)c0);
                     if ((0 < s) && (T[s - 1] > c0))
@@ -2412,25 +2420,35 @@ construct_BWT(uint8_t const * T, saidx_t * SA, saidx_t * bucket_A, saidx_t * buc
     /* Construct the BWTed string by using
        the sorted order of type B suffixes. */
     k = SA + BUCKET_A(c2 = T[n - 1]);
-    *k++ = (T[n - 2] < c2) ? ~((saidx_t)T[n - 2]) : (n - 1);
+    if (T[n - 2] < c2)
+    {
+        report(k - SA, n - 1);
+        *k++ = ~((saidx_t)T[n - 2]);
+    }
+    else
+    {
+        *k++ = n - 1;
+    }
     /* Scan the suffix array from left to right. */
     for (i = SA, j = SA + n, orig = SA; i < j; ++i)
     {
         if (0 < (s = *i))
         {
             assert(T[s - 1] >= T[s]);
+            report(i - SA, s);
             c0 = T[--s];
             *i = c0;
-            if ((0 < s) && (T[s - 1] < c0))
-            {
-                s = ~((saidx_t)T[s - 1]);
-            }
             if (c0 != c2)
             {
                 BUCKET_A(c2) = k - SA;
                 k = SA + BUCKET_A(c2 = c0);
             }
             assert(i < k);
+            if ((0 < s) && (T[s - 1] < c0))
+            {
+                report(k - SA, s);
+                s = ~((saidx_t)T[s - 1]);
+            }
             *k++ = s;
         }
         else if (s != 0)
@@ -2439,6 +2457,7 @@ construct_BWT(uint8_t const * T, saidx_t * SA, saidx_t * bucket_A, saidx_t * buc
         }
         else
         {
+            report(i - SA, 0);
             orig = i;
         }
     }
@@ -2496,6 +2515,60 @@ int32_t divsufsort(uint8_t const * T, saidx_t * SA, saidx_t n)
     return err;
 }
 
+//! Computes the BWT of T[0..n-1] in A[0..n-1] without storing the suffix array.
+/*! A[i] contains T[SA[i]-1] (T[n-1] for SA[i]=0) afterwards. report(i, SA[i]) is
+ *  called once for each i and can be used to sample the suffix array.
+ *  \return The position of suffix 0 or a negative value on error.
+ */
+template <typename saidx_t, typename t_report>
+saidx_t divbwt(uint8_t const * T, saidx_t * A, saidx_t n, t_report && report)
+{
+    saidx_t *bucket_A, *bucket_B;
+    saidx_t m, pidx;
+
+    if ((T == NULL) || (A == NULL) || (n < 0))
+    {
+        return -1;
+    }
+    else if (n <= 2)
+    {
+        int32_t err = divsufsort(T, A, n);
+        if (err != 0)
+        {
+            return err;
+        }
+        for (pidx = 0, m = 0; m < n; ++m)
+        {
+            report(m, A[m]);
+            if (A[m] == 0)
+            {
+                pidx = m;
+            }
+            A[m] = T[A[m] > 0 ? A[m] - 1 : n - 1];
+        }
+        return pidx;
+    }
+
+    bucket_A = (saidx_t *)malloc(BUCKET_A_SIZE * sizeof(saidx_t));
+    bucket_B = (saidx_t *)malloc(BUCKET_B_SIZE * sizeof(saidx_t));
+
+    if ((bucket_A != NULL) && (bucket_B != NULL))
+    {
+        m = sort_typeBstar(T, A, bucket_A, bucket_B, n);
+        pidx = construct_BWT(T, A, bucket_A, bucket_B, n, m, report);
+        A[pidx] = T[n - 1];
+    }
+    else
+    {
+        pidx = -2;
+    }
+
+    free(bucket_B);
+    free(bucket_A);
+
+    return pidx;
+}
+
 // template <typename saidx_t>
 // saidx_t
 // divbwt(const uint8_t *T, uint8_t *U, saidx_t *A, saidx_t n) {
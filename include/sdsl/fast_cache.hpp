@@ -4,45 +4,223 @@
 #ifndef INCLUDED_SDSL_FAST_CACHE
 #define INCLUDED_SDSL_FAST_CACHE
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 #include <sdsl/int_vector.hpp>
 
 namespace sdsl
 {
 
-#define CACHE_SIZE 0x3FFULL
+//! Runtime configuration of the query caches.
+/*! If enabled, SA accesses of csa_wt and select, find_close and find_open of bp_support_sada
+ *  are answered from a cache of the calling thread.
+ *  Both members are atomic, so they can be changed while other threads run queries. A thread
+ *  picks up a new log_size at its next cached query; its cache is then cleared and resized.
+ */
+struct query_cache_config_data
+{
+    std::atomic<bool> enabled{false};  // Use the per-thread query caches.
+    std::atomic<uint8_t> log_size{10}; // Logarithm of the number of entries of each per-thread cache.
+};
+
+extern inline query_cache_config_data & query_cache_config()
+{
+    static query_cache_config_data data;
+    return data;
+}
 
-struct fast_cache
+//! 4-way set associative cache for the answers of integer queries.
+/*! Queries are identified by the id of the owning object and the query argument i.
+ *  The entries of a set are kept in most-recently-used order, the least recently
+ *  used entry is replaced on a write.
+ */
+class fast_cache
 {
+public:
     typedef int_vector<>::size_type size_type;
-    size_type m_table[2 * (CACHE_SIZE + 1)];
-    // Constructor
-    fast_cache()
+    static constexpr size_type ways = 4;
+
+private:
+    struct entry
     {
-        for (size_type i = 0; i < (CACHE_SIZE + 1); ++i)
-        {
-            m_table[i << 1] = (size_type)-1;
-        }
+        uint64_t owner = 0;
+        size_type i = (size_type)-1;
+        size_type x = 0;
+    };
+    std::vector<entry> m_table;
+    uint8_t m_log_size = 0;
+    uint64_t m_mask = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+
+    entry * set_of(uint64_t owner, size_type i)
+    {
+        uint64_t h = (i ^ (owner * 0x9E3779B97F4A7C15ULL)) * 0xC2B2AE3D27D4EB4FULL;
+        return &m_table[((h >> 32) & m_mask) * ways];
+    }
+
+public:
+    //! Constructor
+    /*!\param log_size Logarithm of the number of entries.
+     */
+    fast_cache(uint8_t log_size = 10)
+    {
+        resize(log_size);
+    }
+
+    //! Changes the number of entries to 2^log_size and clears the cache.
+    void resize(uint8_t log_size)
+    {
+        m_log_size = log_size;
+        size_type sets = std::max((size_type)1, ((size_type)1 << log_size) / ways);
+        m_mask = sets - 1;
+        m_table.assign(sets * ways, entry());
+        m_hits = m_misses = 0;
     }
-    // Returns true if the request i is cached and
+
+    //! Logarithm of the number of entries.
+    uint8_t log_size() const
+    {
+        return m_log_size;
+    }
+
+    // Returns true if the request i of owner is cached and
     // x is set to the answer of request i
-    bool exists(size_type i, size_type & x)
+    bool exists(uint64_t owner, size_type i, size_type & x)
     {
-        if (m_table[(i & CACHE_SIZE) << 1] == i)
+        entry * e = set_of(owner, i);
+        for (size_type w = 0; w < ways; ++w)
         {
-            x = m_table[((i & CACHE_SIZE) << 1) + 1];
-            return true;
+            if (e[w].i == i and e[w].owner == owner)
+            {
+                x = e[w].x;
+                std::rotate(e, e + w, e + w + 1); // move entry to the front
+                ++m_hits;
+                return true;
+            }
         }
-        else
-            return false;
+        ++m_misses;
+        return false;
     }
-    // Writes the answer for request i to the cache
+
+    bool exists(size_type i, size_type & x)
+    {
+        return exists(0, i, x);
+    }
+
+    // Writes the answer for request i of owner to the cache
+    void write(uint64_t owner, size_type i, size_type x)
+    {
+        entry * e = set_of(owner, i);
+        std::move_backward(e, e + ways - 1, e + ways);
+        e[0].owner = owner;
+        e[0].i = i;
+        e[0].x = x;
+    }
+
     void write(size_type i, size_type x)
     {
-        m_table[(i & CACHE_SIZE) << 1] = i;
-        m_table[((i & CACHE_SIZE) << 1) + 1] = x;
+        write(0, i, x);
+    }
+
+    //! Number of requests which were found in the cache.
+    uint64_t hits() const
+    {
+        return m_hits;
+    }
+
+    //! Number of requests which were not found in the cache.
+    uint64_t misses() const
+    {
+        return m_misses;
+    }
+};
+
+//! Identifies the owner of cached query answers.
+/*! Each object gets a new id when it is created, copied, moved or assigned. Owners call
+ *  renew() when their content changes otherwise (e.g. in load), so stale answers are never returned.
+ */
+class query_cache_id
+{
+private:
+    uint64_t m_id;
+
+    static uint64_t next()
+    {
+        static std::atomic<uint64_t> cnt{0};
+        return ++cnt;
+    }
+
+public:
+    query_cache_id() : m_id(next())
+    {}
+    query_cache_id(query_cache_id const &) : m_id(next())
+    {}
+    query_cache_id(query_cache_id &&) : m_id(next())
+    {}
+    query_cache_id & operator=(query_cache_id const &)
+    {
+        renew();
+        return *this;
+    }
+    query_cache_id & operator=(query_cache_id &&)
+    {
+        renew();
+        return *this;
+    }
+
+    void renew()
+    {
+        m_id = next();
+    }
+
+    uint64_t id() const
+    {
+        return m_id;
     }
 };
 
+//! Kinds of cached queries. Each kind has its own cache per thread.
+enum class query_cache_kind : uint8_t
+{
+    sa = 0,
+    select = 1,
+    find_close = 2,
+    find_open = 3
+};
+
+//! Returns the cache of the calling thread for queries of the given kind.
+inline fast_cache & query_cache(query_cache_kind kind)
+{
+    thread_local fast_cache caches[4];
+    fast_cache & cache = caches[(uint8_t)kind];
+    uint8_t log_size = query_cache_config().log_size.load(std::memory_order_relaxed);
+    if (cache.log_size() != log_size)
+        cache.resize(log_size);
+    return cache;
+}
+
+//! Answers query i of owner with f() or, if query caching is enabled, from the cache of the calling thread.
+template <class t_func>
+inline int_vector<>::size_type cached_query(query_cache_kind kind,
+                                            query_cache_id const & owner,
+                                            int_vector<>::size_type i,
+                                            t_func && f)
+{
+    if (!query_cache_config().enabled.load(std::memory_order_relaxed))
+        return f();
+    fast_cache & cache = query_cache(kind);
+    int_vector<>::size_type x;
+    if (!cache.exists(owner.id(), i, x))
+    {
+        x = f();
+        cache.write(owner.id(), i, x);
+    }
+    return x;
+}
+
 } // end namespace sdsl
 
 #endif
@@ -0,0 +1,388 @@
+// Copyright (c) 2016, the SDSL Project Authors.  All rights reserved.
+// Please see the AUTHORS file for details.  Use of this source code is governed
+// by a BSD license that can be found in the LICENSE file.
+/*!\file lz_factorization.hpp
+ * \brief lz_factorization.hpp contains LZ77 and relative Lempel-Ziv (RLZ) factorization algorithms.
+ */
+#ifndef INCLUDED_SDSL_LZ_FACTORIZATION
+#define INCLUDED_SDSL_LZ_FACTORIZATION
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sdsl/bits.hpp>
+#include <sdsl/config.hpp>
+#include <sdsl/construct_config.hpp>
+#include <sdsl/int_vector.hpp>
+#include <sdsl/int_vector_buffer.hpp>
+#include <sdsl/io.hpp>
+#include <sdsl/suffix_array_algorithm.hpp>
+#include <sdsl/util.hpp>
+
+namespace sdsl
+{
+
+//! Calculates the LZ77 factorization of text[0..n-1].
+/*! The text is parsed greedily from left to right. Each phrase is either the longest prefix of the
+ *  remaining text which starts at an earlier position (a copy, possibly overlapping with the phrase)
+ *  or a single symbol (a literal). The candidates of a position i are the text positions of its
+ *  previous and next smaller values in the suffix array, which are computed in one scan over sa.
+ *
+ * \param text   Random access container of the text.
+ * \param n      Length of the prefix of text which is factorized.
+ * \param sa     Object which provides the suffix array of text (including the positions >= n) in
+ *               ascending order through sa[0], sa[1], ... ; an int_vector_buffer is read sequentially.
+ * \param report Called with (src, len) for a copy of text[src..src+len-1] and with (c, 0) for a literal c.
+ * \return The number of phrases.
+ *
+ * \par Time complexity
+ *      \f$ \Order{|sa|} \f$
+ * \par Space complexity
+ *      \f$ 2|sa|\log|sa| \f$ bits for the previous and next smaller values plus the stack.
+ * \par Reference
+ *      Juha Kärkkäinen, Dominik Kempa, Simon J. Puglisi:
+ *      Linear Time Lempel-Ziv Factorization: Simple, Fast, Small.
+ *      CPM 2013: 189-200
+ */
+template <class t_text, class t_sa, class t_report>
+uint64_t lz77_factorize(t_text const & text, uint64_t n, t_sa & sa, t_report && report)
+{
+    uint64_t size = sa.size();
+    uint64_t none = size; // marks a missing smaller value
+    uint8_t width = bits::hi(size) + 1;
+    int_vector<> psv(size, none, width), nsv(size, none, width);
+    {
+        std::vector<uint64_t> stack;
+        for (uint64_t k = 0; k < size; ++k)
+        {
+            uint64_t x = sa[k];
+            while (!stack.empty() and stack.back() > x)
+            {
+                uint64_t top = stack.back();
+                stack.pop_back();
+                nsv[top] = x;
+                psv[top] = stack.empty() ? none : stack.back();
+            }
+            stack.push_back(x);
+        }
+        while (!stack.empty())
+        {
+            uint64_t top = stack.back();
+            stack.pop_back();
+            psv[top] = stack.empty() ? none : stack.back();
+        }
+    }
+    uint64_t phrases = 0;
+    for (uint64_t i = 0; i < n; ++phrases)
+    {
+        uint64_t src = 0, len = 0;
+        for (uint64_t cand : {(uint64_t)psv[i], (uint64_t)nsv[i]})
+        {
+            if (cand == none)
+                continue;
+            uint64_t l = 0;
+            while (i + l < n and text[cand + l] == text[i + l])
+                ++l;
+            if (l > len)
+            {
+                src = cand;
+                len = l;
+            }
+        }
+        if (len == 0)
+        {
+            report(text[i], 0);
+            ++i;
+        }
+        else
+        {
+            report(src, len);
+            i += len;
+        }
+    }
+    return phrases;
+}
+
+//! Calculates the LZ77 factorization of the text in the cache.
+/*!\param config Reference to cache configuration
+ *  \pre Text and SA exist in the cache. Keys:
+ *         * conf::KEY_TEXT for t_width=8 or conf::KEY_TEXT_INT for t_width=0
+ *         * conf::KEY_SA
+ *  \post The phrases exist in the cache as pairs (src, len) or (c, 0), see lz77_factorize. Key:
+ *         * conf::KEY_LZ77
+ *  \par Space complexity
+ *         The text and \f$ 2n\log n\f$ bits in memory; the suffix array is streamed from disk.
+ */
+template <uint8_t t_width>
+void construct_lz77(cache_config & config)
+{
+    static_assert(t_width == 0 or t_width == 8,
+                  "construct_lz77: width must be `0` for integer alphabet and `8` for byte alphabet");
+    const char * KEY_TEXT = key_text_trait<t_width>::KEY_TEXT;
+    typedef int_vector<t_width> text_type;
+    text_type text;
+    load_from_cache(text, KEY_TEXT, config);
+    int_vector_buffer<> sa_buf(cache_file_name(conf::KEY_SA, config));
+    int_vector_buffer<> lz_buf(cache_file_name(conf::KEY_LZ77, config), std::ios::out);
+    uint64_t n = text.size() > 0 ? text.size() - 1 : 0; // without the sentinel
+    lz77_factorize(text,
+                   n,
+                   sa_buf,
+                   [&](uint64_t x, uint64_t len)
+                   {
+                       lz_buf.push_back(x);
+                       lz_buf.push_back(len);
+                   });
+    lz_buf.close();
+    register_cache_file(conf::KEY_LZ77, config);
+}
+
+// Calculates for each text position i in [s..e-1] the longest previous factor lpf[i-s] and its source
+// src[i-s] with one scan over the SA and LCP, which are accessed sequentially through sa[k] and lcp[k].
+// Only positions smaller than e are kept on the stack and the positions smaller than s are collapsed to
+// the most recent one, so the memory is bounded by the block size e-s. The previous smaller value is
+// preferred if both candidates have the same length, as in lz77_factorize.
+template <class t_sa, class t_lcp>
+void _lz77_lpf_block(t_sa & sa,
+                     t_lcp & lcp,
+                     uint64_t s,
+                     uint64_t e,
+                     std::vector<uint64_t> & src,
+                     std::vector<uint64_t> & lpf)
+{
+    struct entry
+    {
+        uint64_t x; // text position
+        uint64_t l; // LCP with the entry above it in the stack
+    };
+    uint64_t const inf = (uint64_t)-1;
+    src.assign(e - s, 0);
+    lpf.assign(e - s, 0);
+    std::vector<entry> stack; // increasing text positions; only the bottom entry may be smaller than s
+    uint64_t cur = inf;       // LCP of the top entry with the current suffix
+    for (uint64_t k = 0, size = sa.size(); k < size; ++k)
+    {
+        uint64_t x = sa[k];
+        cur = std::min(cur, (uint64_t)lcp[k]);
+        if (x >= e)
+            continue;
+        while (!stack.empty() and stack.back().x > x)
+        {
+            uint64_t y = stack.back().x;
+            stack.pop_back();
+            if (y >= s and cur > lpf[y - s]) // x is the next smaller value of y
+            {
+                src[y - s] = x;
+                lpf[y - s] = cur;
+            }
+            if (!stack.empty())
+                cur = std::min(cur, stack.back().l);
+        }
+        if (x < s)
+        {
+            stack.clear();
+        }
+        else if (!stack.empty()) // the top is the previous smaller value of x
+        {
+            src[x - s] = stack.back().x;
+            lpf[x - s] = cur;
+        }
+        if (!stack.empty())
+            stack.back().l = cur;
+        stack.push_back({x, 0});
+        cur = inf;
+    }
+}
+
+//! Calculates the LZ77 factorization of the text in the cache semi-externally.
+/*! The result is the same as that of construct_lz77. The text positions are processed in blocks. For each
+ *  block, the longest previous factor of every position of the block is computed by one sequential scan over
+ *  the SA and LCP files; the text itself is only read for literals. Blocks are processed by
+ *  construct_config().num_threads threads in parallel, each thread with its own file buffers, and the
+ *  phrases are written in text order by the calling thread.
+ *
+ * \param config     Reference to cache configuration
+ * \param block_size Number of text positions per block.
+ *  \pre Text, SA and LCP exist in the cache. Keys:
+ *         * conf::KEY_TEXT for t_width=8 or conf::KEY_TEXT_INT for t_width=0
+ *         * conf::KEY_SA
+ *         * conf::KEY_LCP
+ *  \post The phrases exist in the cache as pairs (src, len) or (c, 0), see lz77_factorize. Key:
+ *         * conf::KEY_LZ77
+ *  \par Time complexity
+ *         \f$ \Order{n \cdot \lceil n/block\_size \rceil} \f$ sequential reads.
+ *  \par Space complexity
+ *         \f$ \Order{threads \cdot block\_size} \f$ words in memory plus the file buffers.
+ */
+template <uint8_t t_width>
+void construct_lz77_semi_extern(cache_config & config, uint64_t block_size = 1ULL << 20)
+{
+    static_assert(t_width == 0 or t_width == 8,
+                  "construct_lz77_semi_extern: width must be `0` for integer alphabet and `8` for byte alphabet");
+    const char * KEY_TEXT = key_text_trait<t_width>::KEY_TEXT;
+    block_size = std::max<uint64_t>(1, block_size);
+    uint64_t threads = std::max<uint64_t>(1, construct_config().num_threads);
+    int_vector_buffer<t_width> text_buf(cache_file_name(KEY_TEXT, config));
+    int_vector_buffer<> lz_buf(cache_file_name(conf::KEY_LZ77, config), std::ios::out);
+    uint64_t n = text_buf.size() > 0 ? text_buf.size() - 1 : 0; // without the sentinel
+    std::vector<std::vector<uint64_t>> src(threads), lpf(threads);
+    uint64_t i = 0; // start of the next phrase
+    for (uint64_t first = 0; first < n; first += threads * block_size)
+    {
+        util::run_parallel(threads,
+                           [&](uint64_t t)
+                           {
+                               uint64_t s = std::min(n, first + t * block_size);
+                               uint64_t e = std::min(n, s + block_size);
+                               if (s == e)
+                                   return;
+                               int_vector_buffer<> sa_buf(cache_file_name(conf::KEY_SA, config));
+                               int_vector_buffer<> lcp_buf(cache_file_name(conf::KEY_LCP, config));
+                               _lz77_lpf_block(sa_buf, lcp_buf, s, e, src[t], lpf[t]);
+                           });
+        for (uint64_t last = std::min(n, first + threads * block_size); i < last;)
+        {
+            uint64_t t = (i - first) / block_size, j = (i - first) % block_size;
+            if (lpf[t][j] == 0)
+            {
+                lz_buf.push_back(text_buf[i]);
+                lz_buf.push_back(0);
+                ++i;
+            }
+            else
+            {
+                lz_buf.push_back(src[t][j]);
+                lz_buf.push_back(lpf[t][j]);
+                i += lpf[t][j];
+            }
+        }
+    }
+    lz_buf.close();
+    register_cache_file(conf::KEY_LZ77, config);
+}
+
+// Returns the first phrase (src, len) or (c, 0) of the greedy RLZ factorization of [it..end-1].
+// The longest match is found by galloping and binary search over the length.
+template <class t_csa, class t_iter>
+std::pair<uint64_t, uint64_t> _rlz_phrase(t_csa const & csa, t_iter it, t_iter end)
+{
+    typedef typename t_csa::size_type size_type;
+    size_type max_len = end - it;
+    size_type lb, rb;
+    size_type lo = 0, hi = 1, lo_l = 0, lo_r = csa.size() - 1;
+    while (hi <= max_len and forward_search(csa, lo_l, lo_r, it, it + hi, lb, rb) > 0)
+    {
+        lo = hi;
+        lo_l = lb;
+        lo_r = rb;
+        hi = 2 * hi;
+    }
+    hi = std::min(hi, max_len + 1); // length hi does not match
+    while (lo + 1 < hi)
+    {
+        size_type mid = lo + (hi - lo) / 2;
+        if (forward_search(csa, lo_l, lo_r, it, it + mid, lb, rb) > 0)
+        {
+            lo = mid;
+            lo_l = lb;
+            lo_r = rb;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    if (lo == 0)
+        return {(uint64_t)*it, 0};
+    return {(uint64_t)csa[lo_l], lo};
+}
+
+//! Calculates the relative Lempel-Ziv (RLZ) factorization of a text with respect to a reference.
+/*! The text is parsed greedily: each phrase is the longest prefix of the remaining text which occurs
+ *  in the reference, found by forward search in the CSA of the reference, or a literal if the next
+ *  symbol does not occur in the reference.
+ *
+ * \param csa    CSA of the reference.
+ * \param begin  Iterator to the begin of the text (inclusive).
+ * \param end    Iterator to the end of the text (exclusive).
+ * \param report Called with (src, len) for a copy of reference[src..src+len-1] and with (c, 0) for a literal c.
+ * \return The number of phrases.
+ *
+ * \par Time complexity
+ *      \f$ \Order{ z t_{SA} + \sum_{phrases} \ell \log \ell \log n \cdot t_{\Psi} } \f$
+ */
+template <class t_csa, class t_iter, class t_report>
+uint64_t rlz_factorize(t_csa const & csa, t_iter begin, t_iter end, t_report && report)
+{
+    uint64_t phrases = 0;
+    for (t_iter it = begin; it != end; ++phrases)
+    {
+        auto phrase = _rlz_phrase(csa, it, end);
+        report(phrase.first, phrase.second);
+        it += std::max((uint64_t)1, phrase.second);
+    }
+    return phrases;
+}
+
+//! Parallel RLZ factorization.
+/*! The text is split into one part per thread, and the parts are factorized independently. The calling
+ *  thread then chains the parts: starting at the end of the phrases taken so far, it parses sequentially
+ *  until it reaches a phrase start of the next part, from where on the greedy parse of that part is used.
+ *  The last phrase of a part is always reparsed, as it was cut at the part boundary. The result is the
+ *  same as that of the sequential factorization.
+ *
+ * \param threads Number of threads. Values smaller than 1 are treated as 1.
+ * \sa rlz_factorize(csa, begin, end, report)
+ */
+template <class t_csa, class t_iter, class t_report>
+uint64_t rlz_factorize(t_csa const & csa, t_iter begin, t_iter end, t_report && report, uint64_t threads)
+{
+    threads = std::max<uint64_t>(1, threads);
+    uint64_t n = end - begin;
+    uint64_t part = (n + threads - 1) / threads;
+    std::vector<std::vector<std::pair<uint64_t, uint64_t>>> phrases(threads);
+    std::vector<std::vector<uint64_t>> starts(threads); // start positions of the phrases of each part
+    util::run_parallel(threads,
+                       [&](uint64_t t)
+                       {
+                           uint64_t pos = std::min(n, t * part), last = std::min(n, (t + 1) * part);
+                           rlz_factorize(csa,
+                                         begin + pos,
+                                         begin + last,
+                                         [&](uint64_t x, uint64_t len)
+                                         {
+                                             phrases[t].emplace_back(x, len);
+                                             starts[t].push_back(pos);
+                                             pos += std::max((uint64_t)1, len);
+                                         });
+                       });
+    uint64_t cnt = 0;
+    for (uint64_t pos = 0; pos < n;)
+    {
+        uint64_t t = pos / part;
+        auto it = std::lower_bound(starts[t].begin(), starts[t].end(), pos);
+        uint64_t k = it - starts[t].begin();
+        // use the phrases of part t if pos is one of its phrase starts, except the cut last phrase
+        uint64_t k_end = (t + 1 == threads) ? starts[t].size() : starts[t].size() - 1;
+        if (it != starts[t].end() and *it == pos and k < k_end)
+        {
+            for (; k < k_end; ++k, ++cnt)
+                report(phrases[t][k].first, phrases[t][k].second);
+            pos = (k < starts[t].size()) ? starts[t][k] : n;
+        }
+        else
+        {
+            auto phrase = _rlz_phrase(csa, begin + pos, end);
+            report(phrase.first, phrase.second);
+            ++cnt;
+            pos += std::max((uint64_t)1, phrase.second);
+        }
+    }
+    return cnt;
+}
+
+} // end namespace sdsl
+
+#endif
@@ -0,0 +1,702 @@
+// Copyright (c) 2016, the SDSL Project Authors.  All rights reserved.
+// Please see the AUTHORS file for details.  Use of this source code is governed
+// by a BSD license that can be found in the LICENSE file.
+/*!\file mix_vector.hpp
+ * \brief mix_vector.hpp contains a bit vector which encodes each block as plain, RRR or Elias-Fano bit vector.
+ */
+#ifndef INCLUDED_SDSL_MIX_VECTOR
+#define INCLUDED_SDSL_MIX_VECTOR
+
+#include <algorithm>
+#include <array>
+#include <assert.h>
+#include <cmath>
+#include <iostream>
+#include <stdint.h>
+#include <string>
+
+#include <sdsl/bits.hpp>
+#include <sdsl/cereal.hpp>
+#include <sdsl/int_vector.hpp>
+#include <sdsl/io.hpp>
+#include <sdsl/iterators.hpp>
+#include <sdsl/rank_support_v5.hpp>
+#include <sdsl/rrr_vector.hpp>
+#include <sdsl/sd_vector.hpp>
+#include <sdsl/sdsl_concepts.hpp>
+#include <sdsl/select_support_mcl.hpp>
+#include <sdsl/structure_tree.hpp>
+#include <sdsl/util.hpp>
+
+//! Namespace for the succinct data structure library
+namespace sdsl
+{
+
+// Needed for friend declarations.
+template <uint8_t t_b = 1, uint32_t t_block_size = 1 << 16, uint32_t t_compress_pct = 75>
+class rank_support_mix;
+template <uint8_t t_b = 1, uint32_t t_block_size = 1 << 16, uint32_t t_compress_pct = 75>
+class select_support_mix;
+
+//! A bit vector which chooses the encoding of each block by its density.
+/*!
+ * The bit vector is split into blocks of t_block_size bits. Each block is stored as plain bit vector
+ * (with rank_support_v5 and select_support_mcl), as rrr_vector<63> or as sd_vector<>, whichever the
+ * estimated size favours. The blocks of one encoding are concatenated into one vector of that type.
+ * Wavelet trees store the bit vectors of all nodes one after the other, and the densities of the nodes
+ * of a Huffman shaped tree differ a lot. So `wt_huff<mix_vector<>>` gets a plain encoding for the
+ * balanced nodes and a compressed one for the skewed or clustered nodes.
+ *
+ * \tparam t_block_size   Number of bits per block. Has to be a multiple of 64.
+ * \tparam t_compress_pct Size/speed tradeoff. A block is compressed only if the smaller of its RRR and
+ *                        Elias-Fano encodings takes at most t_compress_pct percent of the plain
+ *                        encoding. 0 stores all blocks plain, 100 minimizes the size.
+ *
+ * \par Space complexity
+ *      The sum of the sizes of the chosen block encodings plus \f$\Order{n/t\_block\_size \cdot \log n}\f$ bits.
+ */
+template <uint32_t t_block_size = 1 << 16, uint32_t t_compress_pct = 75>
+class mix_vector
+{
+    static_assert(t_block_size > 0 and t_block_size % 64 == 0, "mix_vector: t_block_size has to be a multiple of 64");
+    static_assert(t_compress_pct <= 100, "mix_vector: t_compress_pct has to be in [0..100]");
+
+public:
+    typedef bit_vector::size_type size_type;
+    typedef bit_vector::value_type value_type;
+    typedef bit_vector::difference_type difference_type;
+    typedef random_access_const_iterator<mix_vector> iterator;
+    typedef iterator const_iterator;
+    typedef bv_tag index_category;
+    typedef rank_support_mix<1, t_block_size, t_compress_pct> rank_1_type;
+    typedef rank_support_mix<0, t_block_size, t_compress_pct> rank_0_type;
+    typedef select_support_mix<1, t_block_size, t_compress_pct> select_1_type;
+    typedef select_support_mix<0, t_block_size, t_compress_pct> select_0_type;
+    typedef rrr_vector<63> rrr_type;
+    typedef sd_vector<> sd_type;
+
+    friend class rank_support_mix<1, t_block_size, t_compress_pct>;
+    friend class rank_support_mix<0, t_block_size, t_compress_pct>;
+    friend class select_support_mix<1, t_block_size, t_compress_pct>;
+    friend class select_support_mix<0, t_block_size, t_compress_pct>;
+
+    //! Encodings of a block
+    enum encoding : uint8_t
+    {
+        plain = 0,
+        rrr = 1,
+        sd = 2
+    };
+
+private:
+    size_type m_size = 0;
+    int_vector<2> m_enc;       // encoding of each block
+    int_vector<> m_idx;        // index of each block among the blocks of its encoding
+    int_vector<> m_block_rank; // number of ones before each block; the last entry is the number of ones
+    int_vector<> m_enc_rank;   // number of ones before each block in the vector of its encoding
+
+    bit_vector m_plain;
+    rank_support_v5<1, 1> m_plain_rank;
+    select_support_mcl<1, 1> m_plain_sel1;
+    select_support_mcl<0, 1> m_plain_sel0;
+    rrr_type m_rrr;
+    typename rrr_type::rank_1_type m_rrr_rank;
+    typename rrr_type::select_1_type m_rrr_sel1;
+    typename rrr_type::select_0_type m_rrr_sel0;
+    sd_type m_sd;
+    typename sd_type::rank_1_type m_sd_rank;
+    typename sd_type::select_1_type m_sd_sel1;
+    typename sd_type::select_0_type m_sd_sel0;
+
+    void set_supports()
+    {
+        m_plain_rank.set_vector(&m_plain);
+        m_plain_sel1.set_vector(&m_plain);
+        m_plain_sel0.set_vector(&m_plain);
+        m_rrr_rank.set_vector(&m_rrr);
+        m_rrr_sel1.set_vector(&m_rrr);
+        m_rrr_sel0.set_vector(&m_rrr);
+        m_sd_rank.set_vector(&m_sd);
+        m_sd_sel1.set_vector(&m_sd);
+        m_sd_sel0.set_vector(&m_sd);
+    }
+
+    // estimated size in bits of the encodings of the block bv[beg..end-1]
+    static std::array<uint64_t, 3> estimate_sizes(bit_vector const & bv, size_type beg, size_type end)
+    {
+        static std::array<uint8_t, 64> const log_binom = []()
+        {
+            std::array<uint8_t, 64> res;
+            for (uint32_t k = 0; k < 64; ++k)
+                res[k] = std::ceil((std::lgamma(64.0) - std::lgamma(k + 1.0) - std::lgamma(64.0 - k)) / std::log(2.0));
+            return res;
+        }();
+        uint64_t ones = 0;
+        uint64_t rrr_bits = 0;
+        for (size_type i = beg; i < end; i += 63)
+        {
+            uint8_t len = std::min<size_type>(63, end - i);
+            uint32_t k = bits::cnt(bv.get_int(i, len));
+            ones += k;
+            rrr_bits += 6 + log_binom[k];
+        }
+        uint64_t n = end - beg;
+        uint64_t sd_bits = 64;
+        if (ones > 0)
+            sd_bits += ones * (2 + (n / ones > 1 ? bits::hi(n / ones) : 0));
+        // plain: rank_support_v5 and two select_support_mcl, about 0.4 bits per argument together
+        return {n + n / 16 + (4 * n) / 10, rrr_bits + rrr_bits / 8, sd_bits + sd_bits / 8};
+    }
+
+    size_type enc_rank(uint8_t e, size_type i) const
+    {
+        if (e == plain)
+            return m_plain_rank(i);
+        else if (e == rrr)
+            return m_rrr_rank(i);
+        return m_sd_rank(i);
+    }
+
+    template <uint8_t t_b>
+    size_type enc_select(uint8_t e, size_type j) const
+    {
+        if (e == plain)
+            return t_b ? m_plain_sel1(j) : m_plain_sel0(j);
+        else if (e == rrr)
+            return t_b ? m_rrr_sel1(j) : m_rrr_sel0(j);
+        return t_b ? m_sd_sel1(j) : m_sd_sel0(j);
+    }
+
+    value_type enc_access(uint8_t e, size_type i) const
+    {
+        if (e == plain)
+            return m_plain[i];
+        else if (e == rrr)
+            return m_rrr[i];
+        return m_sd[i];
+    }
+
+    uint64_t enc_get_int(uint8_t e, size_type idx, uint8_t len) const
+    {
+        if (e == plain)
+            return m_plain.get_int(idx, len);
+        else if (e == rrr)
+            return m_rrr.get_int(idx, len);
+        return m_sd.get_int(idx, len);
+    }
+
+    // number of ones in [0..i-1]
+    size_type rank1(size_type i) const
+    {
+        size_type b = i / t_block_size;
+        size_type off = i % t_block_size;
+        if (off == 0)
+            return m_block_rank[b];
+        uint8_t e = m_enc[b];
+        return m_block_rank[b] + enc_rank(e, m_idx[b] * t_block_size + off) - m_enc_rank[b];
+    }
+
+    // position of the j-th t_b
+    template <uint8_t t_b>
+    size_type select_b(size_type j) const
+    {
+        // find the last block with less than j t_b's before it
+        size_type lo = 0, hi = m_enc.size();
+        while (hi - lo > 1)
+        {
+            size_type mid = (lo + hi) / 2;
+            size_type before = t_b ? m_block_rank[mid] : mid * t_block_size - m_block_rank[mid];
+            if (before < j)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        size_type b = lo;
+        uint8_t e = m_enc[b];
+        size_type o = m_idx[b] * t_block_size;
+        size_type before = t_b ? m_block_rank[b] : b * t_block_size - m_block_rank[b];
+        size_type enc_before = t_b ? m_enc_rank[b] : o - m_enc_rank[b];
+        return b * t_block_size + enc_select<t_b>(e, enc_before + j - before) - o;
+    }
+
+public:
+    //! Default constructor
+    mix_vector() = default;
+
+    //! Copy constructor
+    mix_vector(mix_vector const & v) :
+        m_size(v.m_size),
+        m_enc(v.m_enc),
+        m_idx(v.m_idx),
+        m_block_rank(v.m_block_rank),
+        m_enc_rank(v.m_enc_rank),
+        m_plain(v.m_plain),
+        m_plain_rank(v.m_plain_rank),
+        m_plain_sel1(v.m_plain_sel1),
+        m_plain_sel0(v.m_plain_sel0),
+        m_rrr(v.m_rrr),
+        m_sd(v.m_sd)
+    {
+        set_supports(); // the supports of m_rrr and m_sd only hold a pointer
+    }
+
+    //! Move constructor
+    mix_vector(mix_vector && v)
+    {
+        *this = std::move(v);
+    }
+
+    //! Constructor
+    /*!\param bv Uncompressed bit vector.
+     */
+    mix_vector(bit_vector const & bv)
+    {
+        m_size = bv.size();
+        size_type blocks = (m_size + t_block_size - 1) / t_block_size;
+        m_enc = int_vector<2>(blocks, plain);
+        m_block_rank = int_vector<>(blocks + 1, 0, bits::hi(m_size | 1) + 1);
+        std::array<size_type, 3> enc_blocks = {0, 0, 0};
+        for (size_type b = 0; b < blocks; ++b)
+        {
+            size_type beg = b * t_block_size, end = std::min(m_size, beg + t_block_size);
+            auto est = estimate_sizes(bv, beg, end);
+            uint8_t best = est[rrr] <= est[sd] ? rrr : sd;
+            if (est[best] * 100 <= est[plain] * t_compress_pct)
+                m_enc[b] = best;
+            ++enc_blocks[m_enc[b]];
+        }
+        std::array<bit_vector, 3> enc_bv;
+        std::array<size_type, 3> enc_ones = {0, 0, 0};
+        for (uint8_t e = 0; e < 3; ++e)
+            enc_bv[e] = bit_vector(enc_blocks[e] * t_block_size, 0);
+        m_idx = int_vector<>(blocks, 0, bits::hi(blocks | 1) + 1);
+        m_enc_rank = int_vector<>(blocks, 0, bits::hi(m_size | 1) + 1);
+        enc_blocks = {0, 0, 0};
+        size_type ones = 0;
+        for (size_type b = 0; b < blocks; ++b)
+        {
+            uint8_t e = m_enc[b];
+            m_block_rank[b] = ones;
+            m_idx[b] = enc_blocks[e];
+            m_enc_rank[b] = enc_ones[e];
+            size_type beg = b * t_block_size, end = std::min(m_size, beg + t_block_size);
+            size_type o = enc_blocks[e]++ * t_block_size;
+            for (size_type i = beg; i < end; i += 64)
+            {
+                uint8_t len = std::min<size_type>(64, end - i);
+                uint64_t x = bv.get_int(i, len);
+                enc_bv[e].set_int(o + i - beg, x, len);
+                ones += bits::cnt(x);
+                enc_ones[e] += bits::cnt(x);
+            }
+        }
+        m_block_rank[blocks] = ones;
+        m_plain = std::move(enc_bv[plain]);
+        m_rrr = rrr_type(enc_bv[rrr]);
+        m_sd = sd_type(enc_bv[sd]);
+        util::init_support(m_plain_rank, &m_plain);
+        util::init_support(m_plain_sel1, &m_plain);
+        util::init_support(m_plain_sel0, &m_plain);
+        util::init_support(m_rrr_rank, &m_rrr);
+        util::init_support(m_rrr_sel1, &m_rrr);
+        util::init_support(m_rrr_sel0, &m_rrr);
+        util::init_support(m_sd_rank, &m_sd);
+        util::init_support(m_sd_sel1, &m_sd);
+        util::init_support(m_sd_sel0, &m_sd);
+    }
+
+    //! Assignment operator
+    mix_vector & operator=(mix_vector const & v)
+    {
+        if (this != &v)
+        {
+            mix_vector tmp(v);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    //! Move assignment operator
+    mix_vector & operator=(mix_vector && v)
+    {
+        if (this != &v)
+        {
+            m_size = v.m_size;
+            m_enc = std::move(v.m_enc);
+            m_idx = std::move(v.m_idx);
+            m_block_rank = std::move(v.m_block_rank);
+            m_enc_rank = std::move(v.m_enc_rank);
+            m_plain = std::move(v.m_plain);
+            m_plain_rank = std::move(v.m_plain_rank);
+            m_plain_sel1 = std::move(v.m_plain_sel1);
+            m_plain_sel0 = std::move(v.m_plain_sel0);
+            m_rrr = std::move(v.m_rrr);
+            m_rrr_rank = std::move(v.m_rrr_rank);
+            m_rrr_sel1 = std::move(v.m_rrr_sel1);
+            m_rrr_sel0 = std::move(v.m_rrr_sel0);
+            m_sd = std::move(v.m_sd);
+            m_sd_rank = std::move(v.m_sd_rank);
+            m_sd_sel1 = std::move(v.m_sd_sel1);
+            m_sd_sel0 = std::move(v.m_sd_sel0);
+            set_supports();
+        }
+        return *this;
+    }
+
+    //! Accessing the i-th element of the original bit vector
+    value_type operator[](size_type i) const
+    {
+        assert(i < m_size);
+        size_type b = i / t_block_size;
+        return enc_access(m_enc[b], m_idx[b] * t_block_size + i % t_block_size);
+    }
+
+    //! Get the integer value of the binary string of length len starting at position idx.
+    /*!\param idx Starting index of the binary representation of the integer.
+     *  \param len Length of the binary representation of the integer. Default value is 64.
+     *  \returns The integer value of the binary string of length len starting at position idx.
+     *
+     *  \pre idx+len-1 in [0..size()-1]
+     *  \pre len in [1..64]
+     */
+    uint64_t get_int(size_type idx, uint8_t const len = 64) const
+    {
+        uint64_t res = 0;
+        for (uint8_t done = 0; done < len;)
+        {
+            size_type b = (idx + done) / t_block_size;
+            size_type off = (idx + done) % t_block_size;
+            uint8_t l = std::min<size_type>(len - done, t_block_size - off);
+            res |= enc_get_int(m_enc[b], m_idx[b] * t_block_size + off, l) << done;
+            done += l;
+        }
+        return res;
+    }
+
+    //! Returns the encoding of the block which contains position i
+    encoding block_encoding(size_type i) const
+    {
+        return (encoding)(uint8_t)m_enc[i / t_block_size];
+    }
+
+    //! Returns the size of the original bit vector
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    //! Serializes the data structure into the given ostream
+    size_type serialize(std::ostream & out, structure_tree_node * v = nullptr, std::string name = "") const
+    {
+        structure_tree_node * child = structure_tree::add_child(v, name, util::class_name(*this));
+        size_type written_bytes = 0;
+        written_bytes += write_member(m_size, out, child, "size");
+        written_bytes += m_enc.serialize(out, child, "enc");
+        written_bytes += m_idx.serialize(out, child, "idx");
+        written_bytes += m_block_rank.serialize(out, child, "block_rank");
+        written_bytes += m_enc_rank.serialize(out, child, "enc_rank");
+        written_bytes += m_plain.serialize(out, child, "plain");
+        written_bytes += m_plain_rank.serialize(out, child, "plain_rank");
+        written_bytes += m_plain_sel1.serialize(out, child, "plain_select_1");
+        written_bytes += m_plain_sel0.serialize(out, child, "plain_select_0");
+        written_bytes += m_rrr.serialize(out, child, "rrr");
+        written_bytes += m_rrr_rank.serialize(out, child, "rrr_rank");
+        written_bytes += m_rrr_sel1.serialize(out, child, "rrr_select_1");
+        written_bytes += m_rrr_sel0.serialize(out, child, "rrr_select_0");
+        written_bytes += m_sd.serialize(out, child, "sd");
+        written_bytes += m_sd_rank.serialize(out, child, "sd_rank");
+        written_bytes += m_sd_sel1.serialize(out, child, "sd_select_1");
+        written_bytes += m_sd_sel0.serialize(out, child, "sd_select_0");
+        structure_tree::add_size(child, written_bytes);
+        return written_bytes;
+    }
+
+    //! Loads the data structure from the given istream
+    void load(std::istream & in)
+    {
+        read_member(m_size, in);
+        m_enc.load(in);
+        m_idx.load(in);
+        m_block_rank.load(in);
+        m_enc_rank.load(in);
+        m_plain.load(in);
+        m_plain_rank.load(in, &m_plain);
+        m_plain_sel1.load(in, &m_plain);
+        m_plain_sel0.load(in, &m_plain);
+        m_rrr.load(in);
+        m_rrr_rank.load(in, &m_rrr);
+        m_rrr_sel1.load(in, &m_rrr);
+        m_rrr_sel0.load(in, &m_rrr);
+        m_sd.load(in);
+        m_sd_rank.load(in, &m_sd);
+        m_sd_sel1.load(in, &m_sd);
+        m_sd_sel0.load(in, &m_sd);
+    }
+
+    template <typename archive_t>
+    void CEREAL_SAVE_FUNCTION_NAME(archive_t & ar) const
+    {
+        ar(CEREAL_NVP(m_size));
+        ar(CEREAL_NVP(m_enc));
+        ar(CEREAL_NVP(m_idx));
+        ar(CEREAL_NVP(m_block_rank));
+        ar(CEREAL_NVP(m_enc_rank));
+        ar(CEREAL_NVP(m_plain));
+        ar(CEREAL_NVP(m_plain_rank));
+        ar(CEREAL_NVP(m_plain_sel1));
+        ar(CEREAL_NVP(m_plain_sel0));
+        ar(CEREAL_NVP(m_rrr));
+        ar(CEREAL_NVP(m_rrr_rank));
+        ar(CEREAL_NVP(m_rrr_sel1));
+        ar(CEREAL_NVP(m_rrr_sel0));
+        ar(CEREAL_NVP(m_sd));
+        ar(CEREAL_NVP(m_sd_rank));
+        ar(CEREAL_NVP(m_sd_sel1));
+        ar(CEREAL_NVP(m_sd_sel0));
+    }
+
+    template <typename archive_t>
+    void CEREAL_LOAD_FUNCTION_NAME(archive_t & ar)
+    {
+        ar(CEREAL_NVP(m_size));
+        ar(CEREAL_NVP(m_enc));
+        ar(CEREAL_NVP(m_idx));
+        ar(CEREAL_NVP(m_block_rank));
+        ar(CEREAL_NVP(m_enc_rank));
+        ar(CEREAL_NVP(m_plain));
+        ar(CEREAL_NVP(m_plain_rank));
+        ar(CEREAL_NVP(m_plain_sel1));
+        ar(CEREAL_NVP(m_plain_sel0));
+        ar(CEREAL_NVP(m_rrr));
+        ar(CEREAL_NVP(m_rrr_rank));
+        ar(CEREAL_NVP(m_rrr_sel1));
+        ar(CEREAL_NVP(m_rrr_sel0));
+        ar(CEREAL_NVP(m_sd));
+        ar(CEREAL_NVP(m_sd_rank));
+        ar(CEREAL_NVP(m_sd_sel1));
+        ar(CEREAL_NVP(m_sd_sel0));
+        set_supports();
+    }
+
+    iterator begin() const
+    {
+        return iterator(this, 0);
+    }
+
+    iterator end() const
+    {
+        return iterator(this, size());
+    }
+
+    bool operator==(mix_vector const & v) const
+    {
+        return m_size == v.m_size && m_enc == v.m_enc && m_idx == v.m_idx && m_block_rank == v.m_block_rank
+            && m_enc_rank == v.m_enc_rank && m_plain == v.m_plain && m_rrr == v.m_rrr && m_sd == v.m_sd;
+    }
+
+    bool operator!=(mix_vector const & v) const
+    {
+        return !(*this == v);
+    }
+};
+
+//! Rank_support for the mix_vector class
+/*!
+ * \tparam t_b            The bit pattern of size one. (so `0` or `1`)
+ * \tparam t_block_size   Block size of the supported mix_vector.
+ * \tparam t_compress_pct Size/speed tradeoff of the supported mix_vector.
+ */
+template <uint8_t t_b, uint32_t t_block_size, uint32_t t_compress_pct>
+class rank_support_mix
+{
+    static_assert(t_b == 1u or t_b == 0u, "rank_support_mix: bit pattern must be `0` or `1`");
+
+public:
+    typedef mix_vector<t_block_size, t_compress_pct> bit_vector_type;
+    typedef typename bit_vector_type::size_type size_type;
+    enum
+    {
+        bit_pat = t_b
+    };
+    enum
+    {
+        bit_pat_len = (uint8_t)1
+    };
+
+private:
+    bit_vector_type const * m_v;
+
+public:
+    //! Standard constructor
+    explicit rank_support_mix(bit_vector_type const * v = nullptr)
+    {
+        set_vector(v);
+    }
+
+    //! Answers rank queries
+    size_type rank(size_type i) const
+    {
+        assert(m_v != nullptr);
+        assert(i <= m_v->size());
+        size_type res = m_v->rank1(i);
+        return t_b ? res : i - res;
+    }
+
+    //! Shorthand for rank(i)
+    size_type operator()(size_type i) const
+    {
+        return rank(i);
+    }
+
+    //! Return the size of the original vector
+    size_type size() const
+    {
+        return m_v->size();
+    }
+
+    //! Set the supported vector
+    void set_vector(bit_vector_type const * v = nullptr)
+    {
+        m_v = v;
+    }
+
+    rank_support_mix(rank_support_mix const &) = default;
+    rank_support_mix(rank_support_mix &&) = default;
+    rank_support_mix & operator=(rank_support_mix const &) = default;
+    rank_support_mix & operator=(rank_support_mix &&) = default;
+
+    //! Load the data structure from a stream and set the supported vector
+    void load(std::istream &, bit_vector_type const * v = nullptr)
+    {
+        set_vector(v);
+    }
+
+    //! Serializes the data structure into a stream
+    size_type serialize(std::ostream &, structure_tree_node * v = nullptr, std::string name = "") const
+    {
+        structure_tree_node * child = structure_tree::add_child(v, name, util::class_name(*this));
+        structure_tree::add_size(child, 0);
+        return 0;
+    }
+
+    template <typename archive_t>
+    void CEREAL_SAVE_FUNCTION_NAME(archive_t &) const
+    {}
+
+    template <typename archive_t>
+    void CEREAL_LOAD_FUNCTION_NAME(archive_t &)
+    {}
+
+    bool operator==(rank_support_mix const & other) const noexcept
+    {
+        return *m_v == *other.m_v;
+    }
+
+    bool operator!=(rank_support_mix const & other) const noexcept
+    {
+        return !(*this == other);
+    }
+};
+
+//! Select support for the mix_vector class
+/*!
+ * \tparam t_b            The bit pattern of size one. (so `0` or `1`)
+ * \tparam t_block_size   Block size of the supported mix_vector.
+ * \tparam t_compress_pct Size/speed tradeoff of the supported mix_vector.
+ *
+ * A binary search over the per block ranks finds the block, the select support of the
+ * block's encoding answers the rest.
+ */
+template <uint8_t t_b, uint32_t t_block_size, uint32_t t_compress_pct>
+class select_support_mix
+{
+    static_assert(t_b == 1u or t_b == 0u, "select_support_mix: bit pattern must be `0` or `1`");
+
+public:
+    typedef mix_vector<t_block_size, t_compress_pct> bit_vector_type;
+    typedef typename bit_vector_type::size_type size_type;
+    enum
+    {
+        bit_pat = t_b
+    };
+    enum
+    {
+        bit_pat_len = (uint8_t)1
+    };
+
+private:
+    bit_vector_type const * m_v;
+
+public:
+    //! Standard constructor
+    explicit select_support_mix(bit_vector_type const * v = nullptr)
+    {
+        set_vector(v);
+    }
+
+    //! Answers select queries
+    size_type select(size_type i) const
+    {
+        assert(m_v != nullptr);
+        return m_v->template select_b<t_b>(i);
+    }
+
+    //! Shorthand for select(i)
+    size_type operator()(size_type i) const
+    {
+        return select(i);
+    }
+
+    //! Return the size of the original vector
+    size_type size() const
+    {
+        return m_v->size();
+    }
+
+    //! Set the supported vector
+    void set_vector(bit_vector_type const * v = nullptr)
+    {
+        m_v = v;
+    }
+
+    select_support_mix(select_support_mix const &) = default;
+    select_support_mix(select_support_mix &&) = default;
+    select_support_mix & operator=(select_support_mix const &) = default;
+    select_support_mix & operator=(select_support_mix &&) = default;
+
+    //! Load the data structure from a stream and set the supported vector
+    void load(std::istream &, bit_vector_type const * v = nullptr)
+    {
+        set_vector(v);
+    }
+
+    //! Serializes the data structure into a stream
+    size_type serialize(std::ostream &, structure_tree_node * v = nullptr, std::string name = "") const
+    {
+        structure_tree_node * child = structure_tree::add_child(v, name, util::class_name(*this));
+        structure_tree::add_size(child, 0);
+        return 0;
+    }
+
+    template <typename archive_t>
+    void CEREAL_SAVE_FUNCTION_NAME(archive_t &) const
+    {}
+
+    template <typename archive_t>
+    void CEREAL_LOAD_FUNCTION_NAME(archive_t &)
+    {}
+
+    bool operator==(select_support_mix const & other) const noexcept
+    {
+        return *m_v == *other.m_v;
+    }
+
+    bool operator!=(select_support_mix const & other) const noexcept
+    {
+        return !(*this == other);
+    }
+};
+
+} // end namespace sdsl
+
+#endif // INCLUDED_SDSL_MIX_VECTOR
@@ -0,0 +1,395 @@
+// Copyright (c) 2016, the SDSL Project Authors.  All rights reserved.
+// Please see the AUTHORS file for details.  Use of this source code is governed
+// by a BSD license that can be found in the LICENSE file.
+/*!\file qgram_table.hpp
+ * \brief qgram_table.hpp contains a table of the SA intervals of all q-grams of a CSA.
+ */
+#ifndef INCLUDED_SDSL_QGRAM_TABLE
+#define INCLUDED_SDSL_QGRAM_TABLE
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <sdsl/bits.hpp>
+#include <sdsl/int_vector.hpp>
+#include <sdsl/sd_vector.hpp>
+#include <sdsl/sdsl_concepts.hpp>
+#include <sdsl/suffix_array_algorithm.hpp>
+#include <sdsl/util.hpp>
+
+namespace sdsl
+{
+
+//! A table of the SA intervals of all q-grams of a CSA.
+/*! The first steps of every pattern search go from the full SA range to the interval of a short
+ *  string. The table stores the SA intervals of all q-grams, so the interval of a string of length
+ *  at most q is found with one lookup.
+ *
+ *  A q-gram is encoded as the number with the q compact characters (csa.char2comp) of its suffix as
+ *  digits to base \f$\sigma\f$; suffixes shorter than q are padded with the sentinel 0. If it fits
+ *  into the space budget, the left border of the interval of every code in \f$[0..\sigma^q]\f$ is
+ *  stored in an int_vector (dense table, two reads per lookup). Otherwise only the codes of the
+ *  occurring q-grams and the left borders of their intervals are stored in two t_bv (sparse table,
+ *  two rank and two select queries per lookup). The value of q is the largest one whose table fits
+ *  into the budget.
+ *
+ *  The table does not own the CSA; as for the rank and select supports of bit vectors the CSA has
+ *  to be set again after loading the table.
+ *
+ * \tparam t_csa Type of the CSA.
+ * \tparam t_bv  Bit vector type for the sparse table.
+ */
+template <class t_csa, class t_bv = sd_vector<>>
+class qgram_table
+{
+public:
+    typedef typename t_csa::size_type size_type;
+    typedef typename t_csa::char_type char_type;
+    typedef t_bv bit_vector_type;
+
+private:
+    t_csa const * m_csa = nullptr;
+    uint8_t m_q = 0;        // length of the q-grams
+    uint64_t m_sigma = 0;   // base of the codes
+    int_vector<> m_dense;   // dense table: left border of each code in [0..sigma^q]
+    bit_vector_type m_codes; // sparse table: codes of the occurring q-grams ...
+    typename bit_vector_type::rank_1_type m_codes_rank;
+    bit_vector_type m_borders; // ... and the left borders of their intervals, plus n
+    typename bit_vector_type::select_1_type m_borders_select;
+
+    void set_supports()
+    {
+        m_codes_rank.set_vector(&m_codes);
+        m_borders_select.set_vector(&m_borders);
+    }
+
+    void build(uint64_t budget_bytes, uint8_t max_q)
+    {
+        size_type n = m_csa->size();
+        m_sigma = std::max<uint64_t>(m_csa->sigma, 2);
+        std::vector<uint64_t> pow(1, 1);
+        while (pow.size() <= max_q and pow.back() <= (1ULL << 60) / m_sigma)
+            pow.push_back(pow.back() * m_sigma);
+        uint8_t q_max = pow.size() - 1;
+        // code of each suffix for q = q_max, in text order
+        std::vector<uint64_t> code(n, 0);
+        {
+            std::vector<char_type> text(n - 1);
+            if (n > 1)
+                extract(*m_csa, 0, n - 2, text.begin());
+            uint64_t c = 0;
+            for (size_type j = 0; j < n + q_max - 1; ++j)
+            {
+                c = (c % pow[q_max - 1]) * m_sigma + (j + 1 < n ? (uint64_t)m_csa->char2comp[text[j]] : 0);
+                if (j + 1 >= q_max)
+                    code[j + 1 - q_max] = c;
+            }
+        }
+        std::sort(code.begin(), code.end());
+        auto distinct = [&](uint8_t q)
+        {
+            uint64_t d = 1, div = pow[q_max - q];
+            for (size_type i = 1; i < n; ++i)
+                d += (code[i] / div) != (code[i - 1] / div);
+            return d;
+        };
+        uint8_t width = bits::hi(n) + 1;
+        auto dense_bits = [&](uint8_t q)
+        {
+            return (double)(pow[q] + 1) * width;
+        };
+        auto sparse_bits = [&](uint8_t q, uint64_t d)
+        {
+            double lg_d = bits::hi(d);
+            return d * (4.0 + std::max(0.0, std::log2((double)pow[q]) - lg_d) + std::max(0.0, width - lg_d));
+        };
+        // largest q whose table fits into the budget, or which already separates all suffixes
+        m_q = 1;
+        for (uint8_t q = 1; q <= q_max; ++q)
+        {
+            uint64_t d = distinct(q);
+            if (q > 1 and std::min(dense_bits(q), sparse_bits(q, d)) > 8.0 * budget_bytes)
+                break;
+            m_q = q;
+            if (d == n)
+                break;
+        }
+        uint64_t div = pow[q_max - m_q];
+        if (m_q == 1 or dense_bits(m_q) <= 8.0 * budget_bytes)
+        {
+            m_dense = int_vector<>(pow[m_q] + 1, 0, width);
+            for (size_type i = 0, c = 0; c <= pow[m_q]; ++c)
+            {
+                while (i < n and code[i] / div < c)
+                    ++i;
+                m_dense[c] = i;
+            }
+            return;
+        }
+        uint64_t d = distinct(m_q);
+        sd_vector_builder codes_builder(pow[m_q], d);
+        sd_vector_builder borders_builder(n + 1, d + 1);
+        for (size_type i = 0; i < n; ++i)
+        {
+            if (i == 0 or (code[i] / div) != (code[i - 1] / div))
+            {
+                codes_builder.set(code[i] / div);
+                borders_builder.set(i);
+            }
+        }
+        borders_builder.set(n);
+        m_codes = bit_vector_type(codes_builder);
+        m_borders = bit_vector_type(borders_builder);
+        util::init_support(m_codes_rank, &m_codes);
+        util::init_support(m_borders_select, &m_borders);
+    }
+
+    // number of suffixes whose q-gram code is smaller than code
+    size_type border(uint64_t code) const
+    {
+        if (!m_dense.empty())
+            return m_dense[code];
+        return m_borders_select(m_codes_rank(code) + 1);
+    }
+
+public:
+    uint8_t const & q = m_q;
+
+    qgram_table() = default;
+
+    //! Constructor
+    /*!\param csa          The CSA.
+     * \param budget_bytes Space budget for the table, which determines q.
+     * \param max_q        Upper bound for q.
+     *
+     * \par Time complexity
+     *      \f$ \Order{ n \cdot t_{extract} + n \log n } \f$ and n 64-bit words of temporary space.
+     */
+    qgram_table(t_csa const & csa, uint64_t budget_bytes = 1ULL << 20, uint8_t max_q = 16) : m_csa(&csa)
+    {
+        if (csa.size() > 0)
+            build(budget_bytes, max_q);
+    }
+
+    qgram_table(qgram_table const & t) :
+        m_csa(t.m_csa),
+        m_q(t.m_q),
+        m_sigma(t.m_sigma),
+        m_dense(t.m_dense),
+        m_codes(t.m_codes),
+        m_borders(t.m_borders)
+    {
+        set_supports();
+    }
+
+    qgram_table(qgram_table && t)
+    {
+        *this = std::move(t);
+    }
+
+    qgram_table & operator=(qgram_table const & t)
+    {
+        if (this != &t)
+        {
+            qgram_table tmp(t);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    qgram_table & operator=(qgram_table && t)
+    {
+        if (this != &t)
+        {
+            m_csa = t.m_csa;
+            m_q = t.m_q;
+            m_sigma = t.m_sigma;
+            m_dense = std::move(t.m_dense);
+            m_codes = std::move(t.m_codes);
+            m_borders = std::move(t.m_borders);
+            set_supports();
+        }
+        return *this;
+    }
+
+    //! Returns whether the dense table is used.
+    bool dense() const
+    {
+        return !m_dense.empty();
+    }
+
+    //! Returns the CSA the table belongs to.
+    t_csa const & csa() const
+    {
+        return *m_csa;
+    }
+
+    //! Sets the CSA, e.g. after loading the table.
+    void set_csa(t_csa const & csa)
+    {
+        m_csa = &csa;
+    }
+
+    //! Looks up the SA interval of a string of length at most q.
+    /*!\param begin Iterator to the begin of the string (inclusive).
+     * \param end   Iterator to the end of the string (exclusive), with end - begin <= q.
+     * \param l_res Left border of the interval.
+     * \param r_res Right border of the interval.
+     * \return The size of the interval, zero if the string does not occur.
+     *
+     * \par Time complexity
+     *      \f$ \Order{1} \f$ for the dense table, \f$ \Order{ t_{rank} + t_{select} } \f$ otherwise.
+     */
+    template <class t_pat_iter>
+    size_type interval(t_pat_iter begin, t_pat_iter end, size_type & l_res, size_type & r_res) const
+    {
+        size_type p = std::distance(begin, end);
+        assert(p <= m_q);
+        uint64_t code = 0, scale = 1;
+        for (auto it = begin; it != end; ++it)
+        {
+            uint64_t c = m_csa->char2comp[(char_type)*it];
+            if (c == 0) // character which does not occur, or the sentinel
+                return backward_search(*m_csa, 0, m_csa->size() - 1, begin, end, l_res, r_res);
+            code = code * m_sigma + c;
+        }
+        for (size_type k = p; k < m_q; ++k)
+            scale *= m_sigma;
+        l_res = border(code * scale);
+        r_res = border((code + 1) * scale) - 1;
+        return r_res + 1 - l_res;
+    }
+
+    //! Searches the SA interval of a pattern, starting with the table lookup of a q-gram of the pattern.
+    /*!\param begin Iterator to the begin of the pattern (inclusive).
+     * \param end   Iterator to the end of the pattern (exclusive).
+     * \param l_res Left border of the interval.
+     * \param r_res Right border of the interval.
+     * \return The size of the interval, zero if the pattern does not occur.
+     *
+     * The search looks up the last q characters and continues with backward_search, or for CSAs
+     * based on \f$\Psi\f$ looks up the first q characters and continues with forward_search.
+     */
+    template <class t_pat_iter>
+    size_type search(t_pat_iter begin, t_pat_iter end, size_type & l_res, size_type & r_res) const
+    {
+        size_type m = std::distance(begin, end);
+        size_type p = std::min<size_type>(m, m_q);
+        if (m > m_csa->size())
+        {
+            l_res = 1;
+            r_res = 0;
+            return 0;
+        }
+        if constexpr (std::is_same<typename t_csa::extract_category, psi_tag>::value)
+        {
+            if (interval(begin, begin + p, l_res, r_res) == 0 or p == m)
+                return r_res + 1 - l_res;
+            size_type l = l_res, r = r_res;
+            return forward_search(*m_csa, l, r, begin, end, l_res, r_res);
+        }
+        if (interval(end - p, end, l_res, r_res) == 0 or p == m)
+            return r_res + 1 - l_res;
+        return backward_search(*m_csa, l_res, r_res, begin, end - p, l_res, r_res);
+    }
+
+    //! Serializes the data structure into the given ostream
+    size_type serialize(std::ostream & out, structure_tree_node * v = nullptr, std::string name = "") const
+    {
+        structure_tree_node * child = structure_tree::add_child(v, name, util::class_name(*this));
+        size_type written_bytes = 0;
+        written_bytes += write_member(m_q, out, child, "q");
+        written_bytes += write_member(m_sigma, out, child, "sigma");
+        written_bytes += m_dense.serialize(out, child, "dense");
+        written_bytes += m_codes.serialize(out, child, "codes");
+        written_bytes += m_codes_rank.serialize(out, child, "codes_rank");
+        written_bytes += m_borders.serialize(out, child, "borders");
+        written_bytes += m_borders_select.serialize(out, child, "borders_select");
+        structure_tree::add_size(child, written_bytes);
+        return written_bytes;
+    }
+
+    //! Loads the data structure from the given istream and sets the CSA.
+    void load(std::istream & in, t_csa const * csa = nullptr)
+    {
+        m_csa = csa;
+        read_member(m_q, in);
+        read_member(m_sigma, in);
+        m_dense.load(in);
+        m_codes.load(in);
+        m_codes_rank.load(in, &m_codes);
+        m_borders.load(in);
+        m_borders_select.load(in, &m_borders);
+    }
+
+    template <typename archive_t>
+    void CEREAL_SAVE_FUNCTION_NAME(archive_t & ar) const
+    {
+        ar(CEREAL_NVP(m_q));
+        ar(CEREAL_NVP(m_sigma));
+        ar(CEREAL_NVP(m_dense));
+        ar(CEREAL_NVP(m_codes));
+        ar(CEREAL_NVP(m_borders));
+    }
+
+    template <typename archive_t>
+    void CEREAL_LOAD_FUNCTION_NAME(archive_t & ar)
+    {
+        ar(CEREAL_NVP(m_q));
+        ar(CEREAL_NVP(m_sigma));
+        ar(CEREAL_NVP(m_dense));
+        ar(CEREAL_NVP(m_codes));
+        ar(CEREAL_NVP(m_borders));
+        set_supports();
+    }
+
+    bool operator==(qgram_table const & other) const noexcept
+    {
+        return (m_q == other.m_q) && (m_sigma == other.m_sigma) && (m_dense == other.m_dense)
+            && (m_codes == other.m_codes) && (m_borders == other.m_borders);
+    }
+
+    bool operator!=(qgram_table const & other) const noexcept
+    {
+        return !(*this == other);
+    }
+};
+
+//! Counts the number of occurrences of a pattern, starting with a q-gram table lookup.
+/*!
+ * \param table The q-gram table of the CSA.
+ * \param begin Iterator to the begin of the pattern (inclusive).
+ * \param end   Iterator to the end of the pattern (exclusive).
+ * \return The number of occurrences of the pattern in the CSA.
+ */
+template <class t_csa, class t_bv, class t_pat_iter>
+typename t_csa::size_type count(qgram_table<t_csa, t_bv> const & table, t_pat_iter begin, t_pat_iter end)
+{
+    typename t_csa::size_type l_res = 0, r_res = 0;
+    return table.search(begin, end, l_res, r_res);
+}
+
+//! Calculates all occurrences of a pattern, starting with a q-gram table lookup.
+/*!
+ * \param table The q-gram table of the CSA.
+ * \param begin Iterator to the begin of the pattern (inclusive).
+ * \param end   Iterator to the end of the pattern (exclusive).
+ * \return A vector containing the occurrences of the pattern in the CSA.
+ */
+template <class t_csa, class t_bv, class t_pat_iter, class t_rac = int_vector<64>>
+t_rac locate(qgram_table<t_csa, t_bv> const & table, t_pat_iter begin, t_pat_iter end)
+{
+    typename t_csa::size_type occ_begin = 0, occ_end = 0;
+    typename t_csa::size_type occs = table.search(begin, end, occ_begin, occ_end);
+    t_rac occ(occs);
+    for (typename t_csa::size_type i = 0; i < occs; ++i)
+        occ[i] = table.csa()[occ_begin + i];
+    return occ;
+}
+
+} // end namespace sdsl
+
+#endif
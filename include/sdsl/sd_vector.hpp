@@ -544,34 +544,58 @@ public:
 private:
     bit_vector_type const * m_v;
 
+    // length of the run of 1s ending at position pos-1 of the high part, read 64 bits at a time
+    size_type ones_before(size_type pos) const
+    {
+        size_type run = 0;
+        while (pos > 0)
+        {
+            uint8_t len = std::min<size_type>(64, pos);
+            uint64_t w = ~(m_v->high.get_int(pos - len, len) << (64 - len));
+            if (w)
+                return run + 63 - bits::hi(w);
+            run += 64;
+            pos -= 64;
+        }
+        return run;
+    }
+
 public:
     explicit rank_support_sd(bit_vector_type const * v = nullptr)
     {
         set_vector(v);
     }
 
+    //! Returns the number of t_b-bits in [0..i-1].
+    /*!\par Time complexity
+     *      \f$ \Order{t_{select0} + \log(n/m)} \f$, independent of the number of ones
+     *      which share the high part of i.
+     */
     size_type rank(size_type i) const
     {
         assert(m_v != nullptr);
         assert(i <= m_v->size());
-        // split problem in two parts:
-        // (1) find  >=
         size_type high_val = (i >> (m_v->wl));
         size_type sel_high = m_v->high_0_select(high_val + 1);
-        size_type rank_low = sel_high - high_val; //
-        if (0 == rank_low)
+        size_type end = sel_high - high_val; // number of ones with high part <= high_val
+        if (0 == end)
             return rank_support_sd_trait<t_b>::adjust_rank(0, i);
+        // the ones with high part == high_val form the run of 1s directly before sel_high
+        size_type begin = end - ones_before(sel_high);
+        // their low parts are strictly increasing; count the ones smaller than val_low
         size_type val_low = i & bits::lo_set[m_v->wl];
-        // now since rank_low > 0 => sel_high > 0
-        do
+        auto const & low = m_v->low;
+        while (end - begin > 8)
         {
-            if (!sel_high)
-                return rank_support_sd_trait<t_b>::adjust_rank(0, i);
-            --sel_high;
-            --rank_low;
+            size_type mid = begin + (end - begin) / 2;
+            if (low[mid] < val_low)
+                begin = mid + 1;
+            else
+                end = mid;
         }
-        while (m_v->high[sel_high] and m_v->low[rank_low] >= val_low);
-        return rank_support_sd_trait<t_b>::adjust_rank(rank_low + 1, i);
+        while (begin < end and low[begin] < val_low)
+            ++begin;
+        return rank_support_sd_trait<t_b>::adjust_rank(begin, i);
     }
 
     size_type operator()(size_type i) const
@@ -29,6 +29,8 @@ struct psi_tag
 {}; // tag for CSAs based on the psi function
 struct lf_tag
 {}; // tag for CSAs based on the LF function
+struct text_tag
+{}; // tag for CSAs with a plain text accessor
 
 struct csa_member_tag
 {}; // tag for text, bwt, LF, \Psi members of CSA
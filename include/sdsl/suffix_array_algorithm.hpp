@@ -8,17 +8,21 @@
 #ifndef INCLUDED_SDSL_SUFFIX_ARRAY_ALGORITHM
 #define INCLUDED_SDSL_SUFFIX_ARRAY_ALGORITHM
 
+#include <algorithm>
 #include <array>
 #include <assert.h>
+#include <atomic>
 #include <iterator>
 #include <stdint.h>
 #include <type_traits>
+#include <vector>
 
 #include <sdsl/config.hpp>
 #include <sdsl/csa_wt.hpp>
 #include <sdsl/int_vector.hpp>
 #include <sdsl/sdsl_concepts.hpp>
 #include <sdsl/suffix_array_helper.hpp>
+#include <sdsl/util.hpp>
 #include <sdsl/wt_pc.hpp>
 
 namespace sdsl
@@ -39,6 +43,16 @@ namespace sdsl
  * \return The size of the new interval [\ell_{new}..r_{new}].
  *         Equals zero, if no match is found.
  *
+ * \par Time complexity
+ *      \f$ \Order{ (m + \log n) \cdot t_{\Psi} } \f$ character comparisons for a pattern of length m.
+ *      The search keeps the number of pattern characters matched at the left and right
+ *      border (Manber and Myers' mlr heuristic) and skips them at each probe; long skips
+ *      are done with one SA and one ISA access instead of single \f$\Psi\f$ steps. Both
+ *      borders are searched together until the first probe which matches the pattern.
+ * \par Reference
+ *         Udi Manber, Gene Myers:
+ *         Suffix Arrays: A New Method for On-Line String Searches.
+ *         SIAM J. Comput. 22(5): 935-948 (1993)
  */
 template <class t_csa, class t_pat_iter>
 typename t_csa::size_type forward_search(
@@ -52,63 +66,113 @@ typename t_csa::size_type forward_search(
     SDSL_UNUSED
     typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag())
 {
+    typedef typename t_csa::size_type size_type;
     assert(l <= r);
     assert(r < csa.size());
 
-    auto size = csa.size();
-
+    size_type m = end - begin;
     l_res = l;
     r_res = l - 1;
-    auto l_res_upper = r + 1;
-    auto r_res_upper = r + 1;
 
     // shortcut for too long patterns
-    if ((typename t_csa::size_type)(end - begin) >= size)
+    if (m >= csa.size())
         return 0;
 
-    // compares the pattern with CSA-prefix i (truncated to length $|pattern|$).
-    auto compare = [&](typename t_csa::size_type i) -> int
+    // returns psi^k(i); beyond the sample densities one SA and one ISA access are cheaper than k psi steps
+    auto psi_k = [&](size_type i, size_type k) -> size_type
+    {
+        if (k > (size_type)t_csa::sa_sample_dens + t_csa::isa_sample_dens)
+            return csa.isa[csa[i] + k];
+        for (; k > 0; --k)
+            i = csa.psi[i];
+        return i;
+    };
+
+    // compares the pattern with CSA-prefix i (truncated to length m), given that the first k
+    // characters are already known to match; k is updated to the length of the match.
+    auto compare = [&](size_type i, size_type & k) -> int
     {
-        for (auto current = begin; current != end; current++)
+        if (k == m)
+            return 0;
+        i = psi_k(i, k);
+        for (auto current = begin + k;; ++current)
         {
-            auto index = csa.char2comp[*current];
+            auto index = csa.char2comp[(typename t_csa::char_type)*current];
             if (index == 0)
                 return -1;
             if (csa.C[index + 1] - 1 < i)
                 return -1;
             if (csa.C[index] > i)
                 return 1;
+            if (++k == m)
+                return 0;
             i = csa.psi[i];
         }
-        return 0;
     };
 
-    // binary search (on min)
-    while (l_res < l_res_upper)
+    // combined binary search for both borders in [lo..hi) until a probe matches;
+    // llcp/rlcp are the matched lengths of the suffixes next to the current borders
+    size_type lo = l, hi = r + 1, llcp = 0, rlcp = 0, mid = 0;
+    int result = -1;
+    while (lo < hi)
     {
-        typename t_csa::size_type sample = l_res + (l_res_upper - l_res) / 2;
-        int result = compare(sample);
+        mid = lo + (hi - lo) / 2;
+        size_type k = std::min(llcp, rlcp);
+        result = compare(mid, k);
+        if (result == 0)
+            break;
         if (result == 1)
-            l_res = sample + 1;
-        else if (result == -1)
-            l_res_upper = sample;
+        {
+            lo = mid + 1;
+            llcp = k;
+        }
         else
-            l_res_upper = sample;
+        {
+            hi = mid;
+            rlcp = k;
+        }
+    }
+    if (result != 0)
+    {
+        l_res = lo;
+        r_res = lo - 1;
+        return 0;
     }
 
-    // binary search (on max)
-    while (r_res + 1 < r_res_upper)
+    // left border: first match in [lo..mid]
+    size_type lo_l = lo, hi_l = mid;
+    while (lo_l < hi_l)
     {
-        typename t_csa::size_type sample = r_res + (r_res_upper - r_res) / 2;
-        int result = compare(sample);
-        if (result == 1)
-            r_res = sample;
-        else if (result == -1)
-            r_res_upper = sample;
+        size_type probe = lo_l + (hi_l - lo_l) / 2;
+        size_type k = llcp;
+        if (compare(probe, k) == 0)
+        {
+            hi_l = probe;
+        }
         else
-            r_res = sample;
+        {
+            lo_l = probe + 1;
+            llcp = k;
+        }
     }
-
+    // right border: last match in [mid..hi)
+    size_type lo_r = mid, hi_r = hi;
+    while (lo_r + 1 < hi_r)
+    {
+        size_type probe = lo_r + (hi_r - lo_r) / 2;
+        size_type k = rlcp;
+        if (compare(probe, k) == 0)
+        {
+            lo_r = probe;
+        }
+        else
+        {
+            hi_r = probe;
+            rlcp = k;
+        }
+    }
+    l_res = lo_l;
+    r_res = lo_r;
     return r_res - l_res + 1;
 }
 
@@ -192,8 +256,9 @@ typename t_csa::size_type backward_search(
         }
         else
         {
-            l_res = c_begin + csa.bwt.rank(l, c);         // count c in bwt[0..l-1]
-            r_res = c_begin + csa.bwt.rank(r + 1, c) - 1; // count c in bwt[0..r]
+            auto ranks = csa.bwt.rank_pair(l, r + 1, c); // count c in bwt[0..l-1] and bwt[0..r]
+            l_res = c_begin + ranks.first;
+            r_res = c_begin + ranks.second - 1;
         }
     }
     assert(r_res + 1 - l_res >= 0);
@@ -247,6 +312,79 @@ typename t_csa::size_type backward_search(
     return r + 1 - l;
 }
 
+//! Backward search for a pattern in an \f$\omega\f$-interval \f$[\ell..r]\f$ in a csa_wt over a byte alphabet.
+/*!
+ * Specialization for CSAs based on a wt_pc (e.g. wt_huff) and byte_alphabet. The alphabet mapping is
+ * done by direct lookups in the byte arrays char2comp and C, and the two rank queries of each step
+ * are answered in one descent of the wavelet tree (see wt_pc::rank_pair).
+ *
+ * \sa backward_search(csa, l, r, begin, end, l_res, r_res)
+ */
+template <class t_shape,
+          class t_bitvector,
+          class t_rank,
+          class t_select,
+          class t_select_zero,
+          class t_tree_strat,
+          uint32_t t_dens,
+          uint32_t t_inv_dens,
+          class t_sa_sample_strat,
+          class t_isa,
+          class t_pat_iter,
+          class t_csa = csa_wt<wt_pc<t_shape, t_bitvector, t_rank, t_select, t_select_zero, t_tree_strat>,
+                               t_dens,
+                               t_inv_dens,
+                               t_sa_sample_strat,
+                               t_isa,
+                               byte_alphabet>>
+typename t_csa::size_type backward_search(
+    csa_wt<wt_pc<t_shape, t_bitvector, t_rank, t_select, t_select_zero, t_tree_strat>,
+           t_dens,
+           t_inv_dens,
+           t_sa_sample_strat,
+           t_isa,
+           byte_alphabet> const & csa,
+    typename t_csa::size_type l,
+    typename t_csa::size_type r,
+    t_pat_iter begin,
+    t_pat_iter end,
+    typename t_csa::size_type & l_res,
+    typename t_csa::size_type & r_res)
+{
+    assert(l <= r);
+    assert(r < csa.size());
+    uint8_t const * char2comp = (uint8_t const *)csa.char2comp.data();
+    uint64_t const * C = csa.C.data();
+    auto const & wt = csa.wavelet_tree;
+    auto n = csa.size();
+    t_pat_iter it = end;
+    while (begin < it and r + 1 - l > 0)
+    {
+        --it;
+        uint8_t c = *it;
+        uint8_t cc = char2comp[c];
+        if (cc == 0 and c > 0)
+        {
+            l = 1;
+            r = 0;
+        }
+        else if (l == 0 and r + 1 == n)
+        {
+            l = C[cc];
+            r = C[cc + 1] - 1;
+        }
+        else
+        {
+            auto ranks = wt.rank_pair(l, r + 1, c);
+            l = C[cc] + ranks.first;
+            r = C[cc] + ranks.second - 1;
+        }
+    }
+    l_res = l;
+    r_res = r;
+    return r + 1 - l;
+}
+
 //! Bidirectional search for a character c on an interval \f$[l_fwd..r_fwd]\f$ of the suffix array.
 /*!
  * \param csa_fwd   The CSA object of the forward text in which the backward_search should be done.
@@ -458,7 +596,8 @@ typename csa_wt<t_wt>::size_type bidirectional_search_forward(
  * \return The number of occurrences of the pattern in the CSA.
  *
  * \par Time complexity
- *        \f$ \Order{ t_{backward\_search} } \f$
+ *        \f$ \Order{ t_{backward\_search} } \f$, or \f$ \Order{ t_{forward\_search} } \f$ for
+ *        CSAs based on \f$\Psi\f$, where the rank on the BWT is a binary search on \f$\Psi\f$.
  */
 template <class t_csa, class t_pat_iter>
 typename t_csa::size_type count(t_csa const & csa, t_pat_iter begin, t_pat_iter end, csa_tag)
@@ -466,6 +605,11 @@ typename t_csa::size_type count(t_csa const & csa, t_pat_iter begin, t_pat_iter
     if (end - begin > (typename std::iterator_traits<t_pat_iter>::difference_type)csa.size())
         return 0;
     typename t_csa::size_type t = 0; // dummy variable for the backward_search call
+    if constexpr (std::is_same<typename t_csa::extract_category, psi_tag>::value)
+    {
+        typename t_csa::size_type l_res = 0, r_res = 0;
+        return forward_search(csa, 0, csa.size() - 1, begin, end, l_res, r_res);
+    }
     typename t_csa::size_type result = backward_search(csa, 0, csa.size() - 1, begin, end, t, t);
     return result;
 }
@@ -496,6 +640,139 @@ typename t_csx::size_type count(t_csx const & csx, const typename t_csx::string_
     return count(csx, pat.begin(), pat.end(), tag);
 }
 
+// Searches all patterns with backward_search on a trie of the reversed patterns. The trie is implicit:
+// the pattern ids are sorted by reversed pattern, so every trie node is a range of ids which share the
+// last `depth` characters. Each node extends the SA interval of its parent by one character, so a
+// suffix shared by several patterns is searched once. report(id, l, r) is called for every pattern
+// (with l > r if it does not occur), concurrently for different ids if threads > 1.
+template <class t_csa, class t_pat, class t_report>
+void _batch_backward_search(t_csa const & csa,
+                            std::vector<t_pat> const & patterns,
+                            t_report && report,
+                            uint64_t threads)
+{
+    typedef typename t_csa::size_type size_type;
+    typedef typename t_csa::char_type char_type;
+    struct node_type
+    {
+        size_type first, last, depth, l, r; // ids[first..last-1] share the last `depth` characters
+    };
+    auto sym = [&](size_type id, size_type depth)
+    {
+        auto const & p = patterns[id];
+        return (char_type)p[p.size() - 1 - depth];
+    };
+    std::vector<size_type> ids(patterns.size());
+    for (size_type i = 0; i < ids.size(); ++i)
+        ids[i] = i;
+    std::sort(ids.begin(),
+              ids.end(),
+              [&](size_type a, size_type b)
+              {
+                  size_type la = patterns[a].size(), lb = patterns[b].size();
+                  for (size_type d = 0; d < la and d < lb; ++d)
+                  {
+                      if (sym(a, d) != sym(b, d))
+                          return sym(a, d) < sym(b, d);
+                  }
+                  return la < lb;
+              });
+    // Reports the patterns which end at node v and calls child(w) for each child w of v.
+    auto expand = [&](node_type const & v, auto && child)
+    {
+        size_type i = v.first;
+        for (; i < v.last and patterns[ids[i]].size() == v.depth; ++i)
+            report(ids[i], v.l, v.r);
+        while (i < v.last)
+        {
+            size_type j = i + 1;
+            char_type c = sym(ids[i], v.depth);
+            while (j < v.last and sym(ids[j], v.depth) == c)
+                ++j;
+            node_type w{i, j, v.depth + 1, v.l, v.r};
+            if (v.r + 1 - v.l > 0)
+                backward_search(csa, v.l, v.r, c, w.l, w.r);
+            if (w.r + 1 - w.l > 0)
+                child(w);
+            else
+                for (size_type k = i; k < j; ++k)
+                    report(ids[k], 1, 0);
+            i = j;
+        }
+    };
+    // Expands the trie breadth-first until there are enough subtries to balance the threads.
+    threads = std::max<uint64_t>(1, threads);
+    std::vector<node_type> tasks{node_type{0, (size_type)ids.size(), 0, 0, csa.size() - 1}};
+    while (threads > 1 and tasks.size() < 16 * threads)
+    {
+        std::vector<node_type> next;
+        for (auto const & v : tasks)
+            expand(v,
+                   [&](node_type const & w)
+                   {
+                       next.push_back(w);
+                   });
+        if (next.empty())
+            break;
+        tasks.swap(next);
+    }
+    std::atomic<size_type> next_task{0};
+    util::run_parallel(threads,
+                       [&](uint64_t)
+                       {
+                           std::vector<node_type> stack;
+                           for (size_type t = next_task++; t < tasks.size(); t = next_task++)
+                           {
+                               stack.push_back(tasks[t]);
+                               while (!stack.empty())
+                               {
+                                   node_type v = stack.back();
+                                   stack.pop_back();
+                                   expand(v,
+                                          [&](node_type const & w)
+                                          {
+                                              stack.push_back(w);
+                                          });
+                               }
+                           }
+                       });
+}
+
+//! Counts the occurrences of each pattern of a set in a CSA.
+/*!
+ * \tparam t_csa CSA type.
+ * \tparam t_pat Random access container of symbols.
+ *
+ * \param csa      The CSA object.
+ * \param patterns The patterns.
+ * \param threads  Number of threads. Values smaller than 1 are treated as 1.
+ * \return The number of occurrences of each pattern.
+ *
+ * The patterns are searched together on a trie of the reversed patterns, so a suffix shared by
+ * several patterns costs one backward search step per character instead of one per pattern.
+ * Independent subtries are searched in parallel.
+ *
+ * \par Time complexity
+ *        \f$ \Order{ M \log k + s \cdot t_{rank\_bwt} } \f$, where \f$k\f$ is the number of patterns,
+ *        \f$M\f$ their total length, and \f$s\f$ the number of nodes of the trie.
+ */
+template <class t_csa, class t_pat>
+std::vector<typename t_csa::size_type> count(t_csa const & csa,
+                                             std::vector<t_pat> const & patterns,
+                                             uint64_t threads = 1)
+{
+    std::vector<typename t_csa::size_type> res(patterns.size(), 0);
+    _batch_backward_search(
+        csa,
+        patterns,
+        [&](typename t_csa::size_type id, typename t_csa::size_type l, typename t_csa::size_type r)
+        {
+            res[id] = r + 1 - l;
+        },
+        threads);
+    return res;
+}
+
 //! Returns the lexicographic interval of a pattern in the SA
 /*!
  * \tparam t_csx      Type of CSA/CST.
@@ -635,6 +912,16 @@ extract(t_csa const & csa, typename t_csa::size_type begin, typename t_csa::size
     return end - begin + 1;
 }
 
+//! Specialization of extract for CSAs with a plain text accessor, see csa_text
+template <class t_csa, class t_text_iter>
+typename t_csa::size_type
+extract(t_csa const & csa, typename t_csa::size_type begin, typename t_csa::size_type end, t_text_iter text, text_tag)
+{
+    assert(end < csa.size());
+    assert(begin <= end);
+    return csa.text_store.extract(begin, end, text);
+}
+
 //! Reconstructs the substring T[begin..end] of the original text T to text[0..end-begin+1].
 /*!
  * \tparam t_rac Random access container which should hold the result.
@@ -284,6 +284,18 @@ public:
         return m_csa.rank_bwt(i, c);
     }
 
+    //! Calculates how many symbols c are in the prefixes [0..i-1] and [0..j-1].
+    /*!
+     *  \param i The exclusive index of the first prefix range, \f$i\leq j\f$.
+     *  \param j The exclusive index of the second prefix range, \f$j\leq size()\f$.
+     *  \param c The symbol to count the occurrences in the prefixes.
+     *    \returns The pair (rank(i,c), rank(j,c)).
+     */
+    std::pair<size_type, size_type> rank_pair(size_type i, size_type j, const char_type c) const
+    {
+        return m_csa.rank_bwt_pair(i, j, c);
+    }
+
     //! Calculates the position of the i-th c.
     /*!
      *  \param i The i-th occurrence. \f$i\in [1..rank(size(),c)]\f$.
@@ -463,6 +475,18 @@ public:
         return m_csa.rank_bwt(i, c);
     }
 
+    //! Calculates how many symbols c are in the prefixes [0..i-1] and [0..j-1].
+    /*!
+     *  \param i The exclusive index of the first prefix range, \f$i\leq j\f$.
+     *  \param j The exclusive index of the second prefix range, \f$j\leq size()\f$.
+     *  \param c The symbol to count the occurrences in the prefixes.
+     *    \returns The pair (rank(i,c), rank(j,c)).
+     */
+    std::pair<size_type, size_type> rank_pair(size_type i, size_type j, const char_type c) const
+    {
+        return m_csa.rank_bwt_pair(i, j, c);
+    }
+
     //! Calculates the position of the i-th c.
     /*!
      *  \param i The i-th occurrence. \f$i\in [1..rank(size(),c)]\f$.
@@ -13,10 +13,13 @@
 #include <stdint.h>
 
 #include <sdsl/csa_alphabet_strategy.hpp>
+#include <sdsl/csa_docs.hpp>
 #include <sdsl/csa_sada.hpp>
 #include <sdsl/csa_sampling_strategy.hpp>
+#include <sdsl/csa_text.hpp>
 #include <sdsl/csa_wt.hpp>
 #include <sdsl/enc_vector.hpp>
+#include <sdsl/qgram_table.hpp>
 #include <sdsl/wt_int.hpp>
 
 // clang-format off
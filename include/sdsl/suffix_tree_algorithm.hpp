@@ -8,15 +8,18 @@
 #ifndef INCLUDED_SDSL_SUFFIX_TREE_ALGORITHM
 #define INCLUDED_SDSL_SUFFIX_TREE_ALGORITHM
 
+#include <algorithm>
 #include <math.h>
 #include <set>
 #include <stddef.h>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <sdsl/config.hpp>
 #include <sdsl/int_vector.hpp>
 #include <sdsl/sdsl_concepts.hpp>
+#include <sdsl/util.hpp>
 
 // clang-format off
 // Cyclic includes start
@@ -286,5 +289,326 @@ std::pair<double, size_t> Hk(t_cst const & cst, typename t_cst::size_type k)
     return {hk, context};
 }
 
+//! An exact match of a query in the text of an index.
+/*! query[query_pos..query_pos+len-1] occurs in the text at the positions SA[lb..rb].
+ */
+struct exact_match
+{
+    typedef int_vector<>::size_type size_type;
+    size_type query_pos = 0;
+    size_type len = 0;
+    size_type lb = 0;
+    size_type rb = 0;
+
+    bool operator==(exact_match const & m) const
+    {
+        return query_pos == m.query_pos and len == m.len and lb == m.lb and rb == m.rb;
+    }
+};
+
+// Scans the query from right to left and calls report(i, ms, lb, rb) for i = m-1, ..., 0, where ms is the
+// length of the longest prefix of query[i..m-1] which occurs in the text and [lb..rb] its SA interval.
+// Mismatches are resolved by moving to the parent of the locus node, which emulates suffix links for the
+// backward direction.
+template <class t_cst, class t_pat_iter, class t_report>
+void _matching_statistics(t_cst const & cst, t_pat_iter begin, t_pat_iter end, t_report && report)
+{
+    typedef typename t_cst::size_type size_type;
+    size_type lb = 0, rb = cst.csa.size() - 1, len = 0, lb_new, rb_new;
+    for (size_type i = end - begin; i > 0; --i)
+    {
+        typename t_cst::char_type c = begin[i - 1];
+        while (true)
+        {
+            if (c != 0 and backward_search(cst.csa, lb, rb, c, lb_new, rb_new) > 0)
+            {
+                lb = lb_new;
+                rb = rb_new;
+                ++len;
+                break;
+            }
+            if (len == 0) // c does not occur in the text
+                break;
+            auto v = cst.parent(cst.node(lb, rb));
+            len = cst.depth(v);
+            lb = cst.lb(v);
+            rb = cst.rb(v);
+        }
+        report(i - 1, len, lb, rb);
+    }
+}
+
+//! Calculates the matching statistics of a query with respect to the text of a CST.
+/*!
+ * \tparam t_cst      CST type.
+ * \tparam t_pat_iter Random access iterator type of the query.
+ *
+ * \param cst   The CST object.
+ * \param begin Iterator to the begin of the query (inclusive).
+ * \param end   Iterator to the end of the query (exclusive).
+ * \return ms, where ms[i] is the length of the longest prefix of query[i..] which occurs in the text.
+ *
+ * \par Time complexity
+ *        \f$ \Order{ m \cdot (t_{rank\_bwt} + t_{parent}) } \f$ amortized, where \f$m\f$ is the length of the query.
+ * \par Reference
+ *         Enno Ohlebusch, Simon Gog, Adrian Kügel:
+ *         Computing Matching Statistics and Maximal Exact Matches on Compressed Full-Text Indexes.
+ *         SPIRE 2010: 347-358
+ */
+template <class t_cst, class t_pat_iter>
+int_vector<> matching_statistics(t_cst const & cst, t_pat_iter begin, t_pat_iter end)
+{
+    int_vector<> ms(end - begin, 0);
+    _matching_statistics(cst,
+                         begin,
+                         end,
+                         [&](uint64_t i, uint64_t len, uint64_t, uint64_t)
+                         {
+                             ms[i] = len;
+                         });
+    return ms;
+}
+
+//! Calculates the super-maximal exact matches (SMEMs) of a query with the text of a CST.
+/*! A SMEM is a match query[i..i+len-1] with len = ms[i] > 0 (right-maximal) which is not contained in
+ *  the match query[j..j+ms[j]-1] of any other query position j. As the end positions j+ms[j] do not
+ *  decrease, this holds exactly for i = 0 and for ms[i-1] <= ms[i]. Each SMEM is reported once with the
+ *  SA interval of all its occurrences in the text; shorter matches inside a SMEM, which occur at other
+ *  text positions, are not reported, see maximal_exact_matches.
+ *
+ * \param cst     The CST object.
+ * \param begin   Iterator to the begin of the query (inclusive).
+ * \param end     Iterator to the end of the query (exclusive).
+ * \param min_len Minimum length of a reported match. SMEMs shorter than min_len are dropped.
+ * \param report  Called with an exact_match for each SMEM in increasing order of query_pos.
+ */
+template <class t_cst, class t_pat_iter, class t_report>
+void super_maximal_exact_matches(t_cst const & cst,
+                                 t_pat_iter begin,
+                                 t_pat_iter end,
+                                 typename t_cst::size_type min_len,
+                                 t_report && report)
+{
+    std::vector<exact_match> smems;
+    exact_match last;
+    bool has_last = false;
+    _matching_statistics(cst,
+                         begin,
+                         end,
+                         [&](uint64_t i, uint64_t len, uint64_t lb, uint64_t rb)
+                         {
+                             if (has_last and len != last.len + 1 and last.len >= min_len and last.len > 0)
+                                 smems.push_back(last);
+                             last = {i, len, lb, rb};
+                             has_last = true;
+                         });
+    if (has_last and last.len >= min_len and last.len > 0)
+        smems.push_back(last);
+    for (auto it = smems.rbegin(); it != smems.rend(); ++it)
+        report(*it);
+}
+
+//! An occurrence of a maximal exact match of a query in the text of an index.
+/*! query[query_pos..query_pos+len-1] equals text[text_pos..text_pos+len-1] and the match can neither be
+ *  extended to the left nor to the right at this pair of positions.
+ */
+struct maximal_exact_match
+{
+    typedef int_vector<>::size_type size_type;
+    size_type query_pos = 0;
+    size_type text_pos = 0;
+    size_type len = 0;
+
+    bool operator==(maximal_exact_match const & m) const
+    {
+        return query_pos == m.query_pos and text_pos == m.text_pos and len == m.len;
+    }
+};
+
+//! Calculates the maximal exact matches (MEMs) of a query with the text of a CST.
+/*! For each query position i the occurrences of query[i..i+ms[i]-1] are right-maximal. The occurrences of
+ *  shorter prefixes query[i..i+d-1] are right-maximal if they are in the interval of an ancestor of depth d
+ *  of the locus, but not in the interval of its child on the path to the locus. An occurrence at text
+ *  position p is left-maximal if i = 0, p = 0 or text[p-1] != query[i-1], which is checked with the BWT.
+ *
+ * \param cst     The CST object.
+ * \param begin   Iterator to the begin of the query (inclusive).
+ * \param end     Iterator to the end of the query (exclusive).
+ * \param min_len Minimum length of a reported match.
+ * \param report  Called with a maximal_exact_match for each MEM, in increasing order of query_pos and
+ *                decreasing order of len for the same query_pos.
+ *
+ * \par Time complexity
+ *        \f$ \Order{ m \cdot (t_{rank\_bwt} + t_{parent}) + occ \cdot (t_{SA} + t_{bwt}) } \f$, where
+ *        \f$occ\f$ is the number of right-maximal occurrences of length at least min_len.
+ * \par Reference
+ *         Enno Ohlebusch, Simon Gog, Adrian Kügel:
+ *         Computing Matching Statistics and Maximal Exact Matches on Compressed Full-Text Indexes.
+ *         SPIRE 2010: 347-358
+ */
+template <class t_cst, class t_pat_iter, class t_report>
+void maximal_exact_matches(t_cst const & cst,
+                           t_pat_iter begin,
+                           t_pat_iter end,
+                           typename t_cst::size_type min_len,
+                           t_report && report)
+{
+    typedef typename t_cst::size_type size_type;
+    std::vector<std::vector<maximal_exact_match>> mems(end - begin);
+    auto report_range = [&](size_type i, size_type len, size_type lb, size_type rb)
+    {
+        for (size_type k = lb; k <= rb; ++k)
+        {
+            if (i == 0 or cst.csa.bwt[k] != (typename t_cst::char_type)begin[i - 1])
+                mems[i].push_back({i, cst.csa[k], len});
+        }
+    };
+    _matching_statistics(cst,
+                         begin,
+                         end,
+                         [&](uint64_t i, uint64_t len, uint64_t lb, uint64_t rb)
+                         {
+                             if (len == 0 or len < min_len)
+                                 return;
+                             report_range(i, len, lb, rb);
+                             auto v = cst.node(lb, rb);
+                             while (v != cst.root())
+                             {
+                                 auto w = cst.parent(v);
+                                 size_type d = cst.depth(w);
+                                 if (d == 0 or d < min_len)
+                                     break;
+                                 if (cst.lb(w) < cst.lb(v))
+                                     report_range(i, d, cst.lb(w), cst.lb(v) - 1);
+                                 if (cst.rb(v) < cst.rb(w))
+                                     report_range(i, d, cst.rb(v) + 1, cst.rb(w));
+                                 v = w;
+                             }
+                         });
+    for (auto const & mems_i : mems)
+        for (auto const & m : mems_i)
+            report(m);
+}
+
+// Processes the queries in rounds of 64 queries per thread. The per-query function matches(cst, begin,
+// end, min_len, report) is called in parallel; the matches of a round are reported in query order by
+// the calling thread.
+template <class t_match, class t_cst, class t_query, class t_matches, class t_report>
+void _batch_matches(t_cst const & cst,
+                    std::vector<t_query> const & queries,
+                    typename t_cst::size_type min_len,
+                    t_matches && matches,
+                    t_report && report,
+                    uint64_t threads)
+{
+    threads = std::max<uint64_t>(1, threads);
+    uint64_t round = threads * 64;
+    std::vector<std::vector<t_match>> res(round);
+    for (uint64_t first = 0; first < queries.size(); first += round)
+    {
+        uint64_t last = std::min((uint64_t)queries.size(), first + round);
+        util::run_parallel(threads,
+                           [&](uint64_t t)
+                           {
+                               for (uint64_t q = first + t; q < last; q += threads)
+                               {
+                                   res[q - first].clear();
+                                   matches(cst,
+                                           queries[q].begin(),
+                                           queries[q].end(),
+                                           min_len,
+                                           [&](t_match const & m)
+                                           {
+                                               res[q - first].push_back(m);
+                                           });
+                               }
+                           });
+        for (uint64_t q = first; q < last; ++q)
+            for (auto const & m : res[q - first])
+                report(q, m);
+    }
+}
+
+//! Calculates the matching statistics of a batch of queries in parallel.
+/*!
+ * \param cst     The CST object.
+ * \param queries The queries, each a random access container of symbols.
+ * \param threads Number of threads. Values smaller than 1 are treated as 1.
+ * \return The matching statistics of each query, see matching_statistics.
+ */
+template <class t_cst, class t_query>
+std::vector<int_vector<>> matching_statistics(t_cst const & cst,
+                                              std::vector<t_query> const & queries,
+                                              uint64_t threads = 1)
+{
+    threads = std::max<uint64_t>(1, threads);
+    std::vector<int_vector<>> ms(queries.size());
+    util::run_parallel(threads,
+                       [&](uint64_t t)
+                       {
+                           for (uint64_t q = t; q < queries.size(); q += threads)
+                               ms[q] = matching_statistics(cst, queries[q].begin(), queries[q].end());
+                       });
+    return ms;
+}
+
+//! Calculates the super-maximal exact matches of a batch of queries in parallel.
+/*! The queries are processed in rounds of 64 queries per thread. The matches of a round are reported
+ *  in query order by the calling thread, so `report` does not have to be thread-safe.
+ *
+ * \param cst     The CST object.
+ * \param queries The queries, each a random access container of symbols.
+ * \param min_len Minimum length of a reported match.
+ * \param report  Called with the query index and an exact_match for each SMEM.
+ * \param threads Number of threads. Values smaller than 1 are treated as 1.
+ */
+template <class t_cst, class t_query, class t_report>
+void super_maximal_exact_matches(t_cst const & cst,
+                                 std::vector<t_query> const & queries,
+                                 typename t_cst::size_type min_len,
+                                 t_report && report,
+                                 uint64_t threads = 1)
+{
+    _batch_matches<exact_match>(
+        cst,
+        queries,
+        min_len,
+        [](auto const &... args)
+        {
+            super_maximal_exact_matches(args...);
+        },
+        report,
+        threads);
+}
+
+//! Calculates the maximal exact matches of a batch of queries in parallel.
+/*! The queries are processed in rounds of 64 queries per thread. The matches of a round are reported
+ *  in query order by the calling thread, so `report` does not have to be thread-safe.
+ *
+ * \param cst     The CST object.
+ * \param queries The queries, each a random access container of symbols.
+ * \param min_len Minimum length of a reported match.
+ * \param report  Called with the query index and a maximal_exact_match for each MEM.
+ * \param threads Number of threads. Values smaller than 1 are treated as 1.
+ */
+template <class t_cst, class t_query, class t_report>
+void maximal_exact_matches(t_cst const & cst,
+                           std::vector<t_query> const & queries,
+                           typename t_cst::size_type min_len,
+                           t_report && report,
+                           uint64_t threads = 1)
+{
+    _batch_matches<maximal_exact_match>(
+        cst,
+        queries,
+        min_len,
+        [](auto const &... args)
+        {
+            maximal_exact_matches(args...);
+        },
+        report,
+        threads);
+}
+
 } // namespace sdsl
 #endif
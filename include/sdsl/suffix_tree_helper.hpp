@@ -4,12 +4,16 @@
 #ifndef INCLUDED_SDSL_SUFFIX_TREE_HELPER
 #define INCLUDED_SDSL_SUFFIX_TREE_HELPER
 
+#include <algorithm>
 #include <cassert>
 #include <iterator>
 #include <stack>
 #include <stdint.h>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
+#include <sdsl/construct_config.hpp>
 #include <sdsl/int_vector.hpp>
 #include <sdsl/int_vector_buffer.hpp>
 #include <sdsl/sorted_multi_stack_support.hpp>
@@ -279,6 +283,152 @@ bit_vector construct_supercartesian_tree_bp_succinct(int_vector_buffer<t_width>
     return bp;
 }
 
+//! Block-parallel construction of the balanced parentheses of the Super-Cartesian tree (minimum version) and the
+//! first_child bit_vector.
+/*! The LCP array is streamed in superblocks which are split into one block per thread. Each block is first simulated
+ *  with a local stack. Pops of elements of preceding blocks are then resolved sequentially against the stack of all
+ *  preceding blocks, which yields the positions of the blocks in bp and bp_fc. Finally, each block writes its part
+ *  of bp and bp_fc. The result is identical to the sequential construction.
+ *  \pre bp and bp_fc have size 2n and n and are initialized with zeros.
+ *  \return The number of ones in bp_fc.
+ */
+template <uint8_t t_width>
+bit_vector::size_type _construct_supercartesian_tree_bp_succinct_and_first_child_par(
+    int_vector_buffer<t_width> & lcp_buf,
+    bit_vector & bp,
+    bit_vector & bp_fc,
+    uint64_t threads)
+{
+    typedef bit_vector::size_type size_type;
+    struct block_info
+    {
+        std::vector<size_type> events;    // values of the elements which are pushed onto the empty local stack
+        std::vector<size_type> survivors; // local stack after the last element of the block
+        std::vector<size_type> pops;      // number of popped elements of preceding blocks per event
+        std::vector<bool> pop_fc;         // first_child bits of the popped elements of preceding blocks
+        std::vector<bool> event_fc;       // first_child bits of the event elements
+        size_type k = 0, k_fc = 0;        // start of the block in bp and bp_fc
+        bit_vector bp, fc;                // part of bp and bp_fc written by the block
+    };
+    size_type n = lcp_buf.size();
+    size_type fc_cnt = 0;
+    sorted_multi_stack_support vec_stack(n); // stack of all elements of the preceding blocks
+    std::vector<size_type> lcp(std::min(n, threads << 18));
+    std::vector<block_info> blocks(threads);
+
+    for (size_type sb = 0; sb < n; sb += lcp.size())
+    {
+        size_type m = std::min((size_type)lcp.size(), n - sb);
+        for (size_type i = 0; i < m; ++i)
+            lcp[i] = lcp_buf[sb + i];
+        size_type part = (m + threads - 1) / threads;
+
+        // (1) simulate each block with a local stack
+        util::run_parallel(threads,
+                           [&](uint64_t b)
+                           {
+                               block_info & blk = blocks[b];
+                               blk.events.clear();
+                               blk.survivors.clear();
+                               size_type end = std::min(m, (b + 1) * part);
+                               for (size_type i = std::min(m, b * part); i < end; ++i)
+                               {
+                                   size_type x = lcp[i];
+                                   while (!blk.survivors.empty() and x < blk.survivors.back())
+                                       blk.survivors.pop_back();
+                                   if (blk.survivors.empty())
+                                       blk.events.push_back(x);
+                                   blk.survivors.push_back(x);
+                               }
+                           });
+        // (2) resolve the events against the stack of the preceding blocks
+        for (size_type b = 0; b < threads; ++b)
+        {
+            block_info & blk = blocks[b];
+            size_type beg = sb + std::min(m, b * part), end = sb + std::min(m, (b + 1) * part);
+            blk.k_fc = beg - vec_stack.size();
+            blk.k = beg + blk.k_fc;
+            blk.pops.assign(blk.events.size(), 0);
+            blk.pop_fc.clear();
+            blk.event_fc.clear();
+            for (size_type e = 0; e < blk.events.size(); ++e)
+            {
+                size_type x = blk.events[e];
+                while (!vec_stack.empty() and x < vec_stack.top())
+                {
+                    blk.pop_fc.push_back(vec_stack.pop());
+                    ++blk.pops[e];
+                }
+                blk.event_fc.push_back(vec_stack.empty() or vec_stack.top() != x);
+            }
+            for (size_type x : blk.survivors)
+                vec_stack.push(x);
+            size_type end_fc = end - vec_stack.size();
+            blk.bp = bit_vector(end + end_fc - blk.k, 0);
+            blk.fc = bit_vector(end_fc - blk.k_fc, 0);
+        }
+        // (3) write the parentheses and first_child bits of each block
+        util::run_parallel(threads,
+                           [&](uint64_t b)
+                           {
+                               block_info & blk = blocks[b];
+                               std::vector<std::pair<size_type, bool>> stack; // (value, first_child bit)
+                               size_type k = 0, k_fc = 0, e = 0, p = 0;
+                               size_type end = std::min(m, (b + 1) * part);
+                               for (size_type i = std::min(m, b * part); i < end; ++i)
+                               {
+                                   size_type x = lcp[i];
+                                   while (!stack.empty() and x < stack.back().first)
+                                   {
+                                       blk.fc[k_fc++] = stack.back().second;
+                                       ++k; // writing a closing parenthesis, bp is already initialized to zeros
+                                       stack.pop_back();
+                                   }
+                                   bool fc;
+                                   if (stack.empty())
+                                   {
+                                       for (size_type j = 0; j < blk.pops[e]; ++j)
+                                       {
+                                           blk.fc[k_fc++] = blk.pop_fc[p++];
+                                           ++k;
+                                       }
+                                       fc = blk.event_fc[e++];
+                                   }
+                                   else
+                                   {
+                                       fc = stack.back().first != x;
+                                   }
+                                   stack.emplace_back(x, fc);
+                                   blk.bp[k++] = 1; // writing an opening parenthesis
+                               }
+                           });
+        for (block_info & blk : blocks)
+        {
+            for (size_type j = 0; j < blk.bp.size(); j += 64)
+            {
+                uint8_t len = std::min((size_type)64, blk.bp.size() - j);
+                bp.set_int(blk.k + j, blk.bp.get_int(j, len), len);
+            }
+            for (size_type j = 0; j < blk.fc.size(); j += 64)
+            {
+                uint8_t len = std::min((size_type)64, blk.fc.size() - j);
+                uint64_t w = blk.fc.get_int(j, len);
+                bp_fc.set_int(blk.k_fc + j, w, len);
+                fc_cnt += bits::cnt(w);
+            }
+        }
+    }
+    for (size_type k_fc = n - vec_stack.size(); !vec_stack.empty(); ++k_fc)
+    {
+        if (vec_stack.pop())
+        {
+            bp_fc[k_fc] = 1;
+            ++fc_cnt;
+        }
+    }
+    return fc_cnt;
+}
+
 //! Calculate the balanced parentheses of the Super-Cartesian tree, described in Ohlebusch and Gog (SPIRE 2009) and the
 //! first_child bit_vector
 /*!\param lcp_buf int_vector_buffer for the lcp array for which the Super-Cartesian tree representation should be
@@ -289,6 +439,8 @@ bit_vector construct_supercartesian_tree_bp_succinct(int_vector_buffer<t_width>
  *       \f$ \Order{2n} \f$, where \f$ n=\f$vec.size()
  *  \par Space complexity
  *       \f$\Order{2n}\f$ bits, by the multi_stack_support
+ *  \par Parallelism
+ *       If minimum is true and construct_config().num_threads > 1 the block-parallel construction is used.
  */
 template <uint8_t t_width>
 bit_vector::size_type construct_supercartesian_tree_bp_succinct_and_first_child(int_vector_buffer<t_width> & lcp_buf,
@@ -305,6 +457,13 @@ bit_vector::size_type construct_supercartesian_tree_bp_succinct_and_first_child(
     size_type fc_cnt = 0; // first child counter
     util::set_to_value(bp, 0);
     util::set_to_value(bp_fc, 0);
+    if (minimum and construct_config().num_threads > 1)
+    {
+        return _construct_supercartesian_tree_bp_succinct_and_first_child_par(lcp_buf,
+                                                                               bp,
+                                                                               bp_fc,
+                                                                               construct_config().num_threads);
+    }
     sorted_multi_stack_support vec_stack(n);
 
     size_type k = 0;
@@ -27,5 +27,7 @@
 #include <sdsl/cst_sct3.hpp>
 // Cyclic includes end
 // clang-format on
+#include <sdsl/cst_node_cache.hpp>
+#include <sdsl/suffix_tree_algorithm.hpp>
 
 #endif
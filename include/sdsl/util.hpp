@@ -13,6 +13,7 @@
 #include <chrono>
 #include <cstdlib>
 #include <errno.h>
+#include <exception>
 #include <iomanip>
 #include <map>
 #include <numeric>
@@ -22,6 +23,7 @@
 #include <stdint.h>  // for uint64_t uint32_t declaration
 #include <string.h>  // for strlen and strdup
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <typeinfo> // for typeid
 #include <utility>
@@ -435,6 +437,63 @@ void init_support(S & s, X const * x)
     s.set_vector(x);     // set the support object's  pointer to x
 }
 
+//! Executes `f(t)` for every thread id t in [0..num_threads-1].
+/*!\param num_threads Number of threads. Values smaller than 1 are treated as 1.
+ * \param f           Callable taking the thread id as argument.
+ *
+ * The call with thread id 0 is executed on the calling thread. If one of the
+ * calls throws, the first exception is rethrown after all threads are joined.
+ */
+template <class t_func>
+void run_parallel(uint64_t num_threads, t_func && f)
+{
+    if (num_threads <= 1)
+    {
+        f((uint64_t)0);
+        return;
+    }
+    std::vector<std::exception_ptr> errors(num_threads);
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (uint64_t t = 1; t < num_threads; ++t)
+    {
+        threads.emplace_back(
+            [&f, &errors, t]()
+            {
+                try
+                {
+                    f(t);
+                }
+                catch (...)
+                {
+                    errors[t] = std::current_exception();
+                }
+            });
+    }
+    try
+    {
+        f((uint64_t)0);
+    }
+    catch (...)
+    {
+        errors[0] = std::current_exception();
+    }
+    for (auto & thread : threads)
+        thread.join();
+    for (auto & error : errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+//! Number of hardware threads, at least 1.
+inline uint64_t hardware_threads()
+{
+    uint64_t threads = std::thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+}
+
 //! Create 2^{log_s} random integers mod m with seed x
 /*
  */
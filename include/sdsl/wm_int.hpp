@@ -354,6 +354,49 @@ public:
         return i;
     };
 
+    //! Calculates how many symbols c are in the prefixes [0..i-1] and [0..j-1] of the supported vector.
+    /*!
+     *  \param i The exclusive index of the first prefix range [0..i-1].
+     *  \param j The exclusive index of the second prefix range [0..j-1].
+     *  \param c The symbol to count the occurrences in the prefixes.
+     *    \returns The pair (rank(i,c), rank(j,c)).
+     *  \par Time complexity
+     *       \f$ \Order{\log |\Sigma|} \f$, both ranks are calculated in one pass over the levels.
+     *  \par Precondition
+     *       \f$ i \leq j \leq size() \f$
+     */
+    std::pair<size_type, size_type> rank_pair(size_type i, size_type j, value_type c) const
+    {
+        assert(i <= j and j <= size());
+        if (((1ULL) << (m_max_level)) <= c)
+        { // c is greater than any symbol in wt
+            return {0, 0};
+        }
+        size_type b = 0; // start position of the interval
+        uint64_t mask = (1ULL) << (m_max_level - 1);
+        for (uint32_t k = 0; k < m_max_level and j; ++k)
+        {
+            size_type rank_b = m_tree_rank(b);
+            size_type ones_i = m_tree_rank(b + i) - rank_b; // ones in [b..b+i)
+            size_type ones_j = m_tree_rank(b + j) - rank_b; // ones in [b..b+j)
+            size_type ones_p = rank_b - m_rank_level[k];    // ones in [level_b..b)
+            if (c & mask)
+            { // search for a one at this level
+                i = ones_i;
+                j = ones_j;
+                b = (k + 1) * m_size + m_zero_cnt[k] + ones_p;
+            }
+            else
+            { // search for a zero at this level
+                i = i - ones_i;
+                j = j - ones_j;
+                b = (k + 1) * m_size + (b - k * m_size - ones_p);
+            }
+            mask >>= 1;
+        }
+        return {i, j};
+    };
+
     //! Calculates how many occurrences of symbol wt[i] are in the prefix [0..i-1] of the original sequence.
     /*!
      *  \param i The index of the symbol.
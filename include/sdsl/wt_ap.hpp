@@ -330,6 +330,31 @@ public:
         return cl < m_singleton_class_cnt ? count : m_offset[cl - m_singleton_class_cnt].rank(count, offset);
     };
 
+    //! Calculates how many symbols c are in the prefixes [0..i-1] and [0..j-1] of the supported vector.
+    /*!
+     *  \param i The exclusive index of the first prefix range [0..i-1].
+     *  \param j The exclusive index of the second prefix range [0..j-1].
+     *  \param c The symbol to count the occurrences in the prefixes.
+     *    \returns The pair (rank(i,c), rank(j,c)).
+     *  \par Precondition
+     *       \f$ i \leq j \leq size() \f$
+     */
+    std::pair<size_type, size_type> rank_pair(size_type i, size_type j, value_type c) const
+    {
+        assert(i <= j and j <= size());
+        auto success_class_offset = try_get_char_class_offset(c);
+        if (!std::get<0>(success_class_offset))
+        {
+            return {0, 0};
+        }
+        auto cl = std::get<1>(success_class_offset);
+        auto offset = std::get<2>(success_class_offset);
+        auto counts = m_class.rank_pair(i, j, cl);
+        return cl < m_singleton_class_cnt
+                 ? counts
+                 : m_offset[cl - m_singleton_class_cnt].rank_pair(counts.first, counts.second, offset);
+    };
+
     //! Calculates how many occurrences of symbol wt[i] are in the prefix [0..i-1] of the original sequence.
     /*!
      *  \param i The index of the symbol.
@@ -230,6 +230,23 @@ public:
         return m_bv_rank.rank(i, c);
     };
 
+    /*!\brief Calculates how many symbols c are in the prefixes [0..i-1] and [0..j-1].
+     * \param i Exclusive right bound of the first range.
+     * \param j Exclusive right bound of the second range.
+     * \param c Symbol c.
+     * \return The pair (rank(i,c), rank(j,c)).
+     * \par Time complexity
+     *      \f$ \Order{1} \f$
+     *
+     * \par Precondition
+     *      \f$ i \leq j \leq size() \f$
+     */
+    std::pair<size_type, size_type> rank_pair(size_type i, size_type j, value_type c) const
+    {
+        assert(i <= j and j <= size());
+        return {m_bv_rank.rank(i, c), m_bv_rank.rank(j, c)};
+    };
+
     /*!\brief Calculates how many times symbol wt[i] occurs in the prefix [0..i-1].
      * \param i The index of the symbol.
      * \return  Pair (rank(wt[i],i),wt[i])
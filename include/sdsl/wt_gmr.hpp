@@ -637,6 +637,21 @@ public:
         return (begin - m_e.begin()) + offset - ones_before_cblock;
     }
 
+    //! Calculates how many symbols c are in the prefixes [0..i-1] and [0..j-1] of the supported vector.
+    /*!
+     *  \param i The exclusive index of the first prefix range [0..i-1].
+     *  \param j The exclusive index of the second prefix range [0..j-1].
+     *  \param c The symbol to count the occurrences in the prefixes.
+     *    \returns The pair (rank(i,c), rank(j,c)).
+     *  \par Precondition
+     *       \f$ i \leq j \leq size() \f$
+     */
+    std::pair<size_type, size_type> rank_pair(size_type i, size_type j, value_type c) const
+    {
+        assert(i <= j and j <= size());
+        return {rank(i, c), rank(j, c)};
+    }
+
     //! Calculates how many symbols c are in the prefix [0..i-1] of the supported vector.
     /*!
      *  \param i The exclusive index of the prefix range [0..i-1], so \f$i\in[0..size()]\f$.
@@ -1126,6 +1141,21 @@ public:
         return c_ones_before_chunk + c_ones_in_chunk;
     }
 
+    //! Calculates how many symbols c are in the prefixes [0..i-1] and [0..j-1] of the supported vector.
+    /*!
+     *  \param i The exclusive index of the first prefix range [0..i-1].
+     *  \param j The exclusive index of the second prefix range [0..j-1].
+     *  \param c The symbol to count the occurrences in the prefixes.
+     *    \returns The pair (rank(i,c), rank(j,c)).
+     *  \par Precondition
+     *       \f$ i \leq j \leq size() \f$
+     */
+    std::pair<size_type, size_type> rank_pair(size_type i, size_type j, value_type c) const
+    {
+        assert(i <= j and j <= size());
+        return {rank(i, c), rank(j, c)};
+    }
+
     //! Calculates how many occurrences of symbol input[i] are in the prefix [0..i-1] of the original input.
     /*!
      *  \param i The index of the symbol.
@@ -408,6 +408,52 @@ public:
         return i;
     };
 
+    //! Calculates how many symbols c are in the prefixes [0..i-1] and [0..j-1] of the supported vector.
+    /*!
+     *  \param i The exclusive index of the first prefix range [0..i-1].
+     *  \param j The exclusive index of the second prefix range [0..j-1].
+     *  \param c The symbol to count the occurrences in the prefixes.
+     *    \returns The pair (rank(i,c), rank(j,c)).
+     *  \par Time complexity
+     *       \f$ \Order{\log |\Sigma|} \f$, both ranks are calculated in one descent of the tree.
+     *  \par Precondition
+     *       \f$ i \leq j \leq size() \f$
+     */
+    std::pair<size_type, size_type> rank_pair(size_type i, size_type j, value_type c) const
+    {
+        assert(i <= j and j <= size());
+        if (((1ULL) << (m_max_level)) <= c)
+        { // c is greater than any symbol in wt
+            return {0, 0};
+        }
+        size_type offset = 0;
+        uint64_t mask = (1ULL) << (m_max_level - 1);
+        size_type node_size = m_size;
+        for (uint32_t k = 0; k < m_max_level and j; ++k)
+        {
+            size_type ones_before_o = m_tree_rank(offset);
+            size_type ones_before_i = m_tree_rank(offset + i) - ones_before_o;
+            size_type ones_before_j = m_tree_rank(offset + j) - ones_before_o;
+            size_type ones_before_end = m_tree_rank(offset + node_size) - ones_before_o;
+            if (c & mask)
+            { // search for a one at this level
+                offset += (node_size - ones_before_end);
+                node_size = ones_before_end;
+                i = ones_before_i;
+                j = ones_before_j;
+            }
+            else
+            { // search for a zero at this level
+                node_size = (node_size - ones_before_end);
+                i = (i - ones_before_i);
+                j = (j - ones_before_j);
+            }
+            offset += m_size;
+            mask >>= 1;
+        }
+        return {i, j};
+    };
+
     //! Calculates how many occurrences of symbol wt[i] are in the prefix [0..i-1] of the original sequence.
     /*!
      *  \param i The index of the symbol.
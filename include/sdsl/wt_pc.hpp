@@ -92,6 +92,8 @@ private:
     select_1_type m_bv_select1; // select support for the wavelet tree bit vector
     select_0_type m_bv_select0;
     tree_strat_type m_tree;
+    // m_sel_samples[b][k] is the position of the (k*sel_sample_rate+1)-th b in m_bv; the last entry is m_bv.size()
+    std::array<int_vector<>, 2> m_sel_samples;
 
     // insert a character into the wavelet tree, see construct method
     void insert_char(value_type old_chr, std::vector<uint64_t> & bv_node_pos, size_type times, bit_vector & bv)
@@ -126,8 +128,91 @@ private:
     void construct_init_rank_select()
     {
         util::init_support(m_bv_rank, &m_bv);
-        util::init_support(m_bv_select0, &m_bv);
-        util::init_support(m_bv_select1, &m_bv);
+        if constexpr (std::is_same<bit_vector_type, bit_vector>::value)
+        {
+            construct_select_samples();
+        }
+        else
+        {
+            util::init_support(m_bv_select0, &m_bv);
+            util::init_support(m_bv_select1, &m_bv);
+        }
+    }
+
+    // samples every sel_sample_rate-th 0 and 1 of m_bv, see select_bv
+    void construct_select_samples()
+    {
+        size_type ones = m_bv_rank(m_bv.size());
+        uint8_t width = bits::hi(m_bv.size() | 1) + 1;
+        m_sel_samples[0] = int_vector<>((m_bv.size() - ones + sel_sample_rate - 1) / sel_sample_rate + 1, 0, width);
+        m_sel_samples[1] = int_vector<>((ones + sel_sample_rate - 1) / sel_sample_rate + 1, 0, width);
+        size_type cnt[2] = {0, 0};
+        uint64_t const * data = m_bv.data();
+        for (size_type w = 0; w * 64 < m_bv.size(); ++w)
+        {
+            uint64_t len = std::min<uint64_t>(64, m_bv.size() - w * 64);
+            uint64_t mask = bits::lo_set[len];
+            for (uint8_t b = 0; b < 2; ++b)
+            {
+                uint64_t x = (b ? data[w] : ~data[w]) & mask;
+                uint32_t pc = bits::cnt(x);
+                // next sampled occurrence is the (cnt[b] + to_next)-th b
+                uint64_t to_next = (sel_sample_rate - cnt[b] % sel_sample_rate) % sel_sample_rate + 1;
+                while (to_next <= pc)
+                {
+                    m_sel_samples[b][(cnt[b] + to_next - 1) / sel_sample_rate] = w * 64 + bits::sel(x, to_next);
+                    to_next += sel_sample_rate;
+                }
+                cnt[b] += pc;
+            }
+        }
+        for (uint8_t b = 0; b < 2; ++b)
+            m_sel_samples[b][m_sel_samples[b].size() - 1] = m_bv.size();
+    }
+
+    // number of b bits in m_bv[0..i-1]
+    template <uint8_t b>
+    size_type rank_bv(size_type i) const
+    {
+        return b ? m_bv_rank(i) : i - m_bv_rank(i);
+    }
+
+    // position of the j-th b in m_bv
+    // For a plain bit vector the samples narrow the search to the gap between two samples, which is halved by
+    // rank queries down to 8 words and then scanned. Other bit vector types use their select supports.
+    template <uint8_t b>
+    size_type select_bv(size_type j) const
+    {
+        if constexpr (std::is_same<bit_vector_type, bit_vector>::value)
+        {
+            int_vector<> const & samples = m_sel_samples[b];
+            size_type k = (j - 1) / sel_sample_rate;
+            size_type wl = samples[k] / 64;
+            size_type wr = (samples[k + 1] + 63) / 64; // the j-th b is in words [wl, wr)
+            while (wr - wl > 8)
+            {
+                size_type mid = (wl + wr) / 2;
+                if (rank_bv<b>(mid * 64) < j)
+                    wl = mid;
+                else
+                    wr = mid;
+            }
+            size_type cnt = rank_bv<b>(wl * 64);
+            uint64_t const * data = m_bv.data() + wl;
+            uint64_t x = b ? *data : ~*data;
+            uint32_t pc = bits::cnt(x);
+            while (cnt + pc < j)
+            {
+                cnt += pc;
+                x = b ? *(++data) : ~*(++data);
+                pc = bits::cnt(x);
+            }
+            return (data - m_bv.data()) * 64 + bits::sel(x, j - cnt);
+        }
+        else
+        {
+            return b ? m_bv_select1(j) : m_bv_select0(j);
+        }
     }
 
     // recursive internal version of the method interval_symbols
@@ -177,6 +262,12 @@ private:
     }
 
 public:
+    //! Sample rate for select on a plain bit_vector.
+    /*! Every sel_sample_rate-th 0 and 1 of the wavelet tree bit vector is stored. These samples replace
+     *  the select supports t_select and t_select_zero, which stay empty in this case.
+     */
+    static constexpr uint32_t sel_sample_rate = 256;
+
     size_type const & sigma = m_sigma;
     bit_vector_type const & bv = m_bv;
 
@@ -259,7 +350,8 @@ public:
         m_bv_rank(wt.m_bv_rank),
         m_bv_select1(wt.m_bv_select1),
         m_bv_select0(wt.m_bv_select0),
-        m_tree(wt.m_tree)
+        m_tree(wt.m_tree),
+        m_sel_samples(wt.m_sel_samples)
     {
         m_bv_rank.set_vector(&m_bv);
         m_bv_select1.set_vector(&m_bv);
@@ -273,7 +365,8 @@ public:
         m_bv_rank(std::move(wt.m_bv_rank)),
         m_bv_select1(std::move(wt.m_bv_select1)),
         m_bv_select0(std::move(wt.m_bv_select0)),
-        m_tree(std::move(wt.m_tree))
+        m_tree(std::move(wt.m_tree)),
+        m_sel_samples(std::move(wt.m_sel_samples))
     {
         m_bv_rank.set_vector(&m_bv);
         m_bv_select1.set_vector(&m_bv);
@@ -306,6 +399,7 @@ public:
             m_bv_select0 = std::move(wt.m_bv_select0);
             m_bv_select0.set_vector(&m_bv);
             m_tree = std::move(wt.m_tree);
+            m_sel_samples = std::move(wt.m_sel_samples);
         }
         return *this;
     }
@@ -398,6 +492,56 @@ public:
         return result;
     };
 
+    //! Calculates how many symbols c are in the prefixes [0..i-1] and [0..j-1].
+    /*!
+     * \param i Exclusive right bound of the first range.
+     * \param j Exclusive right bound of the second range.
+     * \param c Symbol c.
+     * \return The pair (rank(i,c), rank(j,c)).
+     * \par Time complexity
+     *      \f$ \Order{H_0} \f$ on average, where \f$ H_0 \f$ is the
+     *      zero order entropy of the sequence
+     *
+     * Both ranks are calculated in one descent of the tree, the two rank
+     * queries of each level access neighbouring parts of the bitvector.
+     *
+     * \par Precondition
+     *      \f$ i \leq j \leq size() \f$
+     */
+    std::pair<size_type, size_type> rank_pair(size_type i, size_type j, value_type c) const
+    {
+        assert(i <= j and j <= size());
+        if (!m_tree.is_valid(m_tree.c_to_leaf(c)))
+        {
+            return {0, 0}; // if `c` was not in the text
+        }
+        if (m_sigma == 1)
+        {
+            return {i, j}; // if m_sigma == 1 answer is trivial
+        }
+        uint64_t p = m_tree.bit_path(c);
+        uint32_t path_len = (p >> 56);
+        node_type v = m_tree.root();
+        for (uint32_t l = 0; l < path_len and j; ++l, p >>= 1)
+        {
+            size_type pos = m_tree.bv_pos(v), pos_rank = m_tree.bv_pos_rank(v);
+            size_type ones_i = m_bv_rank(pos + i) - pos_rank;
+            size_type ones_j = m_bv_rank(pos + j) - pos_rank;
+            if (p & 1)
+            {
+                i = ones_i;
+                j = ones_j;
+            }
+            else
+            {
+                i -= ones_i;
+                j -= ones_j;
+            }
+            v = m_tree.child(v, p & 1); // goto child
+        }
+        return {i, j};
+    };
+
     //! Calculates how many times symbol wt[i] occurs in the prefix [0..i-1].
     /*!
      * \param i The index of the symbol.
@@ -435,7 +579,9 @@ public:
      * \param c The symbol c.
      * \par Time complexity
      *      \f$ \Order{H_0} \f$ on average, where \f$ H_0 \f$ is the zero order
-     *       entropy of the sequence
+     *       entropy of the sequence. For a plain bit_vector each level costs one
+     *       sample lookup and \f$\Order{\log g}\f$ rank queries, where \f$g\f$ is the
+     *       distance between two samples (see sel_sample_rate).
      *
      * \par Precondition
      *      \f$ 1 \leq i \leq rank(size(), c) \f$
@@ -462,12 +608,12 @@ public:
             if ((p & 0x8000000000000000ULL) == 0)
             { // node was a left child
                 v = m_tree.parent(v);
-                result = m_bv_select0(m_tree.bv_pos(v) - m_tree.bv_pos_rank(v) + result + 1) - m_tree.bv_pos(v);
+                result = select_bv<0>(m_tree.bv_pos(v) - m_tree.bv_pos_rank(v) + result + 1) - m_tree.bv_pos(v);
             }
             else
             { // node was a right child
                 v = m_tree.parent(v);
-                result = m_bv_select1(m_tree.bv_pos_rank(v) + result + 1) - m_tree.bv_pos(v);
+                result = select_bv<1>(m_tree.bv_pos_rank(v) + result + 1) - m_tree.bv_pos(v);
             }
         }
         return result;
@@ -721,6 +867,8 @@ public:
         written_bytes += m_bv_select1.serialize(out, child, "bv_select_1");
         written_bytes += m_bv_select0.serialize(out, child, "bv_select_0");
         written_bytes += m_tree.serialize(out, child, "tree");
+        written_bytes += m_sel_samples[0].serialize(out, child, "sel_samples_0");
+        written_bytes += m_sel_samples[1].serialize(out, child, "sel_samples_1");
         structure_tree::add_size(child, written_bytes);
         return written_bytes;
     }
@@ -735,6 +883,8 @@ public:
         m_bv_select1.load(in, &m_bv);
         m_bv_select0.load(in, &m_bv);
         m_tree.load(in);
+        m_sel_samples[0].load(in);
+        m_sel_samples[1].load(in);
     }
 
     //! Equality operator.
@@ -742,7 +892,8 @@ public:
     {
         return (m_size == other.m_size) && (m_sigma == other.m_sigma) && (m_bv == other.m_bv)
             && (m_bv_rank == other.m_bv_rank) && (m_bv_select1 == other.m_bv_select1)
-            && (m_bv_select0 == other.m_bv_select0) && (m_tree == other.m_tree);
+            && (m_bv_select0 == other.m_bv_select0) && (m_tree == other.m_tree)
+            && (m_sel_samples == other.m_sel_samples);
     }
 
     //! Inequality operator.
@@ -761,6 +912,7 @@ public:
         ar(CEREAL_NVP(m_bv_select1));
         ar(CEREAL_NVP(m_bv_select0));
         ar(CEREAL_NVP(m_tree));
+        ar(CEREAL_NVP(m_sel_samples));
     }
 
     template <typename archive_t>
@@ -776,6 +928,7 @@ public:
         ar(CEREAL_NVP(m_bv_select0));
         m_bv_select0.set_vector(&m_bv);
         ar(CEREAL_NVP(m_tree));
+        ar(CEREAL_NVP(m_sel_samples));
     }
 
     //! Random access container to bitvector of node v
@@ -156,6 +156,23 @@ private:
                                      // the prefixes m_bf[0..m_C[0]],m_bf[0..m_C[1]],....,m_bf[0..m_C[255]];
                                      // named C_s in the original paper
 
+    // Number of symbols c in the prefix [0..i-1], given the number wt_ex_pos of runs which
+    // start in the prefix and the number c_runs of those runs which consist of c.
+    size_type rank_in_runs(size_type i, size_type wt_ex_pos, size_type c_runs, value_type c) const
+    {
+        if (c_runs == 0)
+            return 0;
+        if (m_wt[wt_ex_pos - 1] == c)
+        {
+            size_type c_run_begin = m_bl_select(wt_ex_pos);
+            return m_bf_select(m_C_bf_rank[c] + c_runs) - m_C[c] + i - c_run_begin;
+        }
+        else
+        {
+            return m_bf_select(m_C_bf_rank[c] + c_runs + 1) - m_C[c];
+        }
+    }
+
 public:
     size_type const & sigma = m_wt.sigma;
 
@@ -349,18 +366,28 @@ public:
         if (i == 0)
             return 0;
         size_type wt_ex_pos = m_bl_rank(i);
-        size_type c_runs = m_wt.rank(wt_ex_pos, c);
-        if (c_runs == 0)
-            return 0;
-        if (m_wt[wt_ex_pos - 1] == c)
-        {
-            size_type c_run_begin = m_bl_select(wt_ex_pos);
-            return m_bf_select(m_C_bf_rank[c] + c_runs) - m_C[c] + i - c_run_begin;
-        }
-        else
-        {
-            return m_bf_select(m_C_bf_rank[c] + c_runs + 1) - m_C[c];
-        }
+        return rank_in_runs(i, wt_ex_pos, m_wt.rank(wt_ex_pos, c), c);
+    };
+
+    //! Calculates how many symbols c are in the prefixes [0..i-1] and [0..j-1].
+    /*!
+     *  \param i Exclusive right bound of the first range.
+     *  \param j Exclusive right bound of the second range (\f$i\leq j\leq size()\f$).
+     *  \param c Symbol c.
+     *  \return The pair (rank(i,c), rank(j,c)).
+     *  \par Time complexity
+     *        \f$ \Order{H_0} \f$ on average, the runs of both prefixes are counted
+     *        with one rank_pair query on the wavelet tree of the run heads.
+     */
+    std::pair<size_type, size_type> rank_pair(size_type i, size_type j, value_type c) const
+    {
+        assert(i <= j and j <= size());
+        if (j == 0)
+            return {0, 0};
+        size_type wt_ex_pos_i = m_bl_rank(i);
+        size_type wt_ex_pos_j = m_bl_rank(j);
+        auto c_runs = m_wt.rank_pair(wt_ex_pos_i, wt_ex_pos_j, c);
+        return {rank_in_runs(i, wt_ex_pos_i, c_runs.first, c), rank_in_runs(j, wt_ex_pos_j, c_runs.second, c)};
     };
 
     //! Calculates how many times symbol wt[i] occurs in the prefix [0..i-1].
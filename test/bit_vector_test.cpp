@@ -3,6 +3,7 @@
 #include <sdsl/bit_vector_il.hpp>
 #include <sdsl/hyb_vector.hpp>
 #include <sdsl/int_vector.hpp>
+#include <sdsl/mix_vector.hpp>
 #include <sdsl/rrr_vector.hpp>
 #include <sdsl/sd_vector.hpp>
 
@@ -51,12 +52,15 @@ typedef Types<bit_vector,
               rrr_vector<128>,
               sd_vector<>,
               sd_vector<rrr_vector<63>>,
-              hyb_vector<>>
+              hyb_vector<>,
+              mix_vector<>,
+              mix_vector<1024, 0>,
+              mix_vector<1024, 100>>
     Implementations;
 
 #else
 
-typedef Types<bit_vector, bit_vector_il<>, rrr_vector<>, sd_vector<>, hyb_vector<>> Implementations;
+typedef Types<bit_vector, bit_vector_il<>, rrr_vector<>, sd_vector<>, hyb_vector<>, mix_vector<1024>> Implementations;
 
 #endif
 
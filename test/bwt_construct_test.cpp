@@ -0,0 +1,156 @@
+#include <string>
+#include <vector>
+
+#include <sdsl/construct.hpp>
+#include <sdsl/construct_bwt.hpp>
+#include <sdsl/construct_config.hpp>
+#include <sdsl/csa_wt.hpp>
+
+#include "common.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sdsl;
+using namespace std;
+
+namespace
+{
+string test_file, temp_dir, temp_file;
+
+class bwt_construct_test : public ::testing::Test
+{
+protected:
+    bwt_construct_test()
+    {}
+
+    virtual ~bwt_construct_test()
+    {}
+
+    virtual void SetUp()
+    {
+        config = cache_config(false, temp_dir, to_string(util::pid()));
+        int_vector<8> text;
+        ASSERT_TRUE(load_vector_from_file(text, test_file, 1));
+        ASSERT_TRUE(contains_no_zero_symbol(text, test_file));
+        append_zero_symbol(text);
+        ASSERT_TRUE(store_to_cache(text, conf::KEY_TEXT, config));
+        n = text.size();
+        sa = int_vector<>(n, 0, bits::hi(n) + 1);
+        algorithm::calculate_sa((unsigned char const *)text.data(), n, sa);
+        ASSERT_TRUE(store_to_cache(sa, conf::KEY_SA, config));
+        bwt_check = int_vector<8>(n);
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            bwt_check[i] = text[sa[i] > 0 ? sa[i] - 1 : n - 1];
+        }
+    }
+
+    virtual void TearDown()
+    {
+        construct_config().num_threads = 1;
+        util::delete_all_files(config.file_map);
+    }
+
+    void check_bwt()
+    {
+        int_vector<8> bwt;
+        ASSERT_TRUE(load_from_cache(bwt, conf::KEY_BWT, config));
+        ASSERT_EQ(n, bwt.size());
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            ASSERT_EQ(bwt_check[i], bwt[i]) << " bwt differs at position " << i;
+        }
+    }
+
+    void check_samples(uint64_t sa_dens, uint64_t isa_dens)
+    {
+        check_bwt();
+        int_vector<> sa_sample, isa_sample;
+        ASSERT_TRUE(load_from_cache(sa_sample, key_sa_sample(sa_dens), config));
+        ASSERT_TRUE(load_from_cache(isa_sample, key_isa_sample(isa_dens), config));
+        ASSERT_EQ((n + sa_dens - 1) / sa_dens, sa_sample.size());
+        for (uint64_t i = 0; i < n; i += sa_dens)
+        {
+            ASSERT_EQ(sa[i], sa_sample[i / sa_dens]) << " sa sample differs at position " << i;
+        }
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            if (sa[i] % isa_dens == 0)
+            {
+                ASSERT_EQ(i, isa_sample[sa[i] / isa_dens]) << " isa sample differs at position " << sa[i];
+            }
+        }
+    }
+
+    cache_config config;
+    uint64_t n = 0;
+    int_vector<> sa;
+    int_vector<8> bwt_check;
+};
+
+TEST_F(bwt_construct_test, sequential)
+{
+    construct_config().num_threads = 1;
+    construct_bwt<8>(config);
+    check_bwt();
+}
+
+TEST_F(bwt_construct_test, parallel)
+{
+    for (uint64_t threads : {2, 3, 8})
+    {
+        construct_config().num_threads = threads;
+        construct_bwt<8>(config);
+        check_bwt();
+    }
+}
+
+TEST_F(bwt_construct_test, samples)
+{
+    construct_config().num_threads = 3;
+    construct_bwt<8>(config, 4, 7);
+    check_samples(4, 7);
+}
+
+TEST_F(bwt_construct_test, induced)
+{
+    remove_from_cache<int_vector<>>(conf::KEY_SA, config);
+    construct_bwt_is(config, 4, 7);
+    ASSERT_FALSE(cache_file_exists(conf::KEY_SA, config));
+    check_samples(4, 7);
+}
+
+TEST_F(bwt_construct_test, induced_dense_samples)
+{
+    remove_from_cache<int_vector<>>(conf::KEY_SA, config);
+    construct_bwt_is(config, 1, 1);
+    check_samples(1, 1);
+}
+
+TEST_F(bwt_construct_test, csa_without_sa)
+{
+    csa_wt<> csa_sa_free, csa_sa;
+    construct_config().sa_free_bwt = true;
+    construct(csa_sa_free, test_file, 1);
+    construct_config().sa_free_bwt = false;
+    construct(csa_sa, test_file, 1);
+    construct_config().sa_free_bwt = true;
+    ASSERT_EQ(n, csa_sa_free.size());
+    ASSERT_TRUE(csa_sa == csa_sa_free);
+    for (uint64_t i = 0; i < n; ++i)
+    {
+        ASSERT_EQ(sa[i], csa_sa_free[i]) << " sa differs at position " << i;
+    }
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    if (init_2_arg_test(argc, argv, "BWT_CONSTRUCT", test_file, temp_dir, temp_file) != 0)
+    {
+        return 1;
+    }
+    return RUN_ALL_TESTS();
+}
@@ -1,3 +1,4 @@
+#include <random>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -6,7 +7,10 @@
 #include <sdsl/coder_fibonacci.hpp>
 #include <sdsl/csa_bitcompressed.hpp>
 #include <sdsl/csa_sada.hpp>
+#include <sdsl/csa_text.hpp>
 #include <sdsl/csa_wt.hpp>
+#include <sdsl/mix_vector.hpp>
+#include <sdsl/qgram_table.hpp>
 #include <sdsl/suffix_array_algorithm.hpp>
 
 #include "common.hpp"
@@ -39,6 +43,7 @@ typedef Types<csa_wt<>,
               csa_bitcompressed<>,
               csa_sada<enc_vector<coder::fibonacci<>>>,
               csa_sada<enc_vector<coder::elias_gamma<>>>,
+              csa_wt<wt_huff<mix_vector<>>>,
               csa_wt<wt_huff<>, 8, 16, text_order_sa_sampling<>>,
               csa_wt<wt_huff<>, 32, 32, fuzzy_sa_sampling<>>,
               csa_wt<wt_huff<>, 32, 32, fuzzy_sa_sampling<bit_vector, bit_vector>, fuzzy_isa_sampling_support<>>,
@@ -55,12 +60,14 @@ typedef Types<csa_wt<>,
                      isa_sampling<>,
                      succinct_byte_alphabet<bit_vector, rank_support_v<>, select_support_mcl<>>>,
               csa_wt<wt_huff<>, 8, 16, sa_order_sa_sampling<>, isa_sampling<>, succinct_byte_alphabet<>>,
-              csa_wt<wt_huff<>, 8, 16, sa_order_sa_sampling<>, isa_sampling<>, plain_byte_alphabet>>
+              csa_wt<wt_huff<>, 8, 16, sa_order_sa_sampling<>, isa_sampling<>, plain_byte_alphabet>,
+              csa_text<csa_wt<>>,
+              csa_text<csa_sada<>, block_text<64>>>
     Implementations;
 
 #else
 
-typedef Types<csa_wt<>, csa_sada<>, csa_bitcompressed<>> Implementations;
+typedef Types<csa_wt<>, csa_sada<>, csa_bitcompressed<>, csa_text<csa_wt<>>> Implementations;
 
 #endif
 
@@ -105,6 +112,38 @@ TYPED_TEST(csa_byte_test, backward_search)
     ASSERT_EQ(r_res, (size_type)(csa.size() - 1));
 }
 
+//! Test that backward_search for a pattern equals the search character by character
+TYPED_TEST(csa_byte_test, backward_search_pattern_vs_chars)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    if (csa.size() < 2)
+        return;
+    std::mt19937_64 rng(7);
+    for (size_type k = 0; k < 1000; ++k)
+    {
+        std::string pat;
+        size_type len = 1 + rng() % 20;
+        size_type pos = rng() % (csa.size() - 1);
+        pat = extract(csa, pos, std::min(csa.size() - 2, pos + len - 1));
+        if (k % 10 == 0) // pattern with a character which may not occur
+            pat[rng() % pat.size()] = (char)(1 + rng() % 255);
+        typename TypeParam::size_type lb, rb, l = 0, r = csa.size() - 1;
+        auto cnt = backward_search(csa, 0, csa.size() - 1, pat.begin(), pat.end(), lb, rb);
+        for (auto it = pat.end(); it != pat.begin() and r + 1 - l > 0;)
+        {
+            --it;
+            backward_search(csa, l, r, (typename TypeParam::char_type)*it, l, r);
+        }
+        ASSERT_EQ(r + 1 - l, cnt) << " pat=" << pat;
+        if (cnt > 0)
+        {
+            ASSERT_EQ(l, lb);
+            ASSERT_EQ(r, rb);
+        }
+    }
+}
+
 //! Test forward_search
 TYPED_TEST(csa_byte_test, forward_search)
 {
@@ -133,6 +172,126 @@ TYPED_TEST(csa_byte_test, forward_search)
     ASSERT_EQ(r_res, (size_type)(csa.size() - 1));
 }
 
+//! Test that forward_search and count agree with backward_search
+TYPED_TEST(csa_byte_test, forward_search_vs_backward_search)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    if (csa.size() < 2)
+        return;
+    std::mt19937_64 rng(11);
+    for (size_type k = 0; k < 1000; ++k)
+    {
+        size_type len = 1 + rng() % (k % 2 ? 200 : 10);
+        size_type pos = rng() % (csa.size() - 1);
+        std::string pat = extract(csa, pos, std::min(csa.size() - 2, pos + len - 1));
+        if (k % 10 == 0) // pattern with a character which may not occur
+            pat[rng() % pat.size()] = (char)(1 + rng() % 255);
+        size_type lb, rb, l_res, r_res;
+        auto cnt = backward_search(csa, 0, csa.size() - 1, pat.begin(), pat.end(), lb, rb);
+        ASSERT_EQ(cnt, forward_search(csa, 0, csa.size() - 1, pat.begin(), pat.end(), l_res, r_res))
+            << " pat=" << pat;
+        ASSERT_EQ(cnt, sdsl::count(csa, pat.begin(), pat.end()));
+        if (cnt > 0)
+        {
+            ASSERT_EQ(lb, l_res);
+            ASSERT_EQ(rb, r_res);
+            // search again inside the interval of the first character
+            size_type l1, r1;
+            forward_search(csa, 0, csa.size() - 1, pat.begin(), pat.begin() + 1, l1, r1);
+            ASSERT_EQ(cnt, forward_search(csa, l1, r1, pat.begin(), pat.end(), l_res, r_res));
+            ASSERT_EQ(lb, l_res);
+            ASSERT_EQ(rb, r_res);
+        }
+    }
+}
+
+//! Test the q-gram table against backward_search
+TYPED_TEST(csa_byte_test, qgram_table)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    if (csa.size() < 2)
+        return;
+    for (uint64_t budget : {0ULL, 1ULL << 12, 1ULL << 16, 1ULL << 24})
+    {
+        sdsl::qgram_table<TypeParam> table(csa, budget);
+        ASSERT_LE((uint8_t)1, table.q);
+        std::string file = temp_dir + "/qgram_table_" + util::to_string(util::pid());
+        ASSERT_TRUE(store_to_file(table, file));
+        sdsl::qgram_table<TypeParam> loaded;
+        ASSERT_TRUE(load_from_file(loaded, file));
+        loaded.set_csa(csa);
+        sdsl::remove(file);
+        ASSERT_TRUE(loaded == table);
+        std::mt19937_64 rng(13);
+        for (size_type k = 0; k < 500; ++k)
+        {
+            size_type len = rng() % (2 * table.q + 2);
+            size_type pos = rng() % (csa.size() - 1);
+            std::string pat;
+            if (len > 0)
+                pat = extract(csa, pos, std::min(csa.size() - 2, pos + len - 1));
+            if (k % 10 == 0 and !pat.empty()) // pattern with a character which may not occur
+                pat[rng() % pat.size()] = (char)(1 + rng() % 255);
+            size_type lb = 0, rb = 0, l_res = 0, r_res = 0;
+            auto cnt = backward_search(csa, 0, csa.size() - 1, pat.begin(), pat.end(), lb, rb);
+            ASSERT_EQ(cnt, loaded.search(pat.begin(), pat.end(), l_res, r_res)) << " pat=" << pat;
+            if (cnt > 0)
+            {
+                ASSERT_EQ(lb, l_res);
+                ASSERT_EQ(rb, r_res);
+            }
+            if (pat.size() <= table.q)
+            {
+                ASSERT_EQ(cnt, table.interval(pat.begin(), pat.end(), l_res, r_res));
+                if (cnt > 0)
+                {
+                    ASSERT_EQ(lb, l_res);
+                }
+            }
+            ASSERT_EQ(cnt, sdsl::count(table, pat.begin(), pat.end()));
+            if (cnt <= 100)
+            {
+                auto occ = sdsl::locate(table, pat.begin(), pat.end());
+                ASSERT_EQ(cnt, occ.size());
+                for (size_type i = 0; i < occ.size(); ++i)
+                    ASSERT_EQ(csa[lb + i], occ[i]);
+            }
+        }
+    }
+}
+
+//! Test that counting a set of patterns equals counting each pattern
+TYPED_TEST(csa_byte_test, count_batch)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    if (csa.size() < 2)
+        return;
+    std::mt19937_64 rng(17);
+    std::vector<std::string> patterns(1, std::string());
+    for (size_type k = 0; k < 1000; ++k)
+    {
+        size_type end = rng() % (csa.size() - 1);
+        if (k % 2) // shared suffixes: several patterns ending at the same position
+            end = patterns.size() % (csa.size() - 1);
+        size_type len = 1 + rng() % 20;
+        std::string pat = extract(csa, end >= len ? end - len + 1 : 0, end);
+        if (k % 10 == 0) // pattern with a character which may not occur
+            pat[rng() % pat.size()] = (char)(1 + rng() % 255);
+        patterns.push_back(pat);
+    }
+    for (uint64_t threads : {1, 4})
+    {
+        auto cnt = sdsl::count(csa, patterns, threads);
+        ASSERT_EQ(patterns.size(), cnt.size());
+        for (size_type i = 0; i < patterns.size(); ++i)
+            ASSERT_EQ(sdsl::count(csa, patterns[i].begin(), patterns[i].end()), cnt[i])
+                << " pat=" << patterns[i] << " threads=" << threads;
+    }
+}
+
 //! Test sigma member
 TYPED_TEST(csa_byte_test, sigma)
 {
@@ -231,6 +390,31 @@ TYPED_TEST(csa_byte_test, text_access)
     }
 }
 
+//! Test extract on substrings which do not start at the beginning of the text
+TYPED_TEST(csa_byte_test, extract)
+{
+    if (test_case_file_map.find(conf::KEY_TEXT) != test_case_file_map.end())
+    {
+        TypeParam csa;
+        ASSERT_TRUE(load_from_file(csa, temp_file));
+        int_vector<8> text;
+        load_from_file(text, test_case_file_map[conf::KEY_TEXT]);
+        size_type n = text.size();
+        std::mt19937_64 rng(13);
+        for (size_type k = 0; k < 100; ++k)
+        {
+            size_type begin = rng() % n;
+            size_type end = std::min(n - 1, begin + rng() % 300);
+            auto ex_text = extract(csa, begin, end);
+            ASSERT_EQ(end - begin + 1, ex_text.size());
+            for (size_type j = begin; j <= end; ++j)
+            {
+                ASSERT_EQ(text[j], (decltype(text[j]))ex_text[j - begin]) << " j=" << j;
+            }
+        }
+    }
+}
+
 //! Test Burrows-Wheeler access methods
 TYPED_TEST(csa_byte_test, bwt_access)
 {
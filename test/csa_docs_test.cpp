@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sdsl/csa_docs.hpp>
+#include <sdsl/suffix_arrays.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using namespace sdsl;
+using namespace std;
+
+template <class T>
+class csa_docs_test : public ::testing::Test
+{};
+
+using testing::Types;
+
+typedef Types<csa_docs<csa_wt<>>, csa_docs<csa_sada<>, 1, bit_vector>, csa_docs<csa_bitcompressed<>>> Implementations;
+
+TYPED_TEST_SUITE(csa_docs_test, Implementations, );
+
+// collection of random documents over {a,b,c}, each terminated by '\1'
+vector<string> random_docs(uint64_t d, uint64_t seed)
+{
+    mt19937_64 rng(seed);
+    vector<string> docs(d);
+    for (auto & doc : docs)
+    {
+        doc.resize(rng() % 200);
+        for (auto & c : doc)
+            c = 'a' + rng() % 3;
+        doc += '\1';
+    }
+    return docs;
+}
+
+TYPED_TEST(csa_docs_test, locate_and_count_docs)
+{
+    auto docs = random_docs(100, 7);
+    string text;
+    for (auto const & doc : docs)
+        text += doc;
+    TypeParam csa;
+    construct_im(csa, text, 1);
+    ASSERT_EQ(docs.size(), csa.docs());
+
+    TypeParam csa2 = csa; // copies must be usable
+    ASSERT_TRUE(csa == csa2);
+    for (string pat : {"a", "ab", "abc", "cab", "ccc", "aaaa", "abcabc", "x", "c\1a"})
+    {
+        vector<pair<uint64_t, uint64_t>> expected;
+        vector<uint64_t> expected_docs;
+        for (uint64_t d = 0; d < docs.size(); ++d)
+        {
+            for (size_t pos = docs[d].find(pat); pos != string::npos; pos = docs[d].find(pat, pos + 1))
+                expected.emplace_back(d, pos);
+            if (docs[d].find(pat) != string::npos)
+                expected_docs.push_back(d);
+        }
+        // occurrences which span two documents start in the first one
+        for (size_t pos = text.find(pat); pos != string::npos; pos = text.find(pat, pos + 1))
+        {
+            uint64_t d = csa.doc(pos);
+            if (pos + pat.size() > csa.doc_start(d) + docs[d].size())
+                expected.emplace_back(d, pos - csa.doc_start(d));
+        }
+        sort(expected.begin(), expected.end());
+        auto res = locate_docs(csa2, pat);
+        ASSERT_EQ(expected, res) << " pat=" << pat;
+        if (pat.find('\1') == string::npos)
+        {
+            ASSERT_EQ(expected_docs, list_docs(csa2, pat.begin(), pat.end())) << " pat=" << pat;
+            ASSERT_EQ(expected_docs.size(), count_docs(csa2, pat)) << " pat=" << pat;
+        }
+    }
+}
+
+TYPED_TEST(csa_docs_test, list_docs_of_intervals)
+{
+    auto docs = random_docs(300, 11);
+    string text;
+    for (auto const & doc : docs)
+        text += doc;
+    TypeParam csa;
+    construct_im(csa, text, 1);
+    mt19937_64 rng(5);
+    for (uint64_t q = 0; q < 1000; ++q)
+    {
+        uint64_t lb = rng() % csa.size(), rb = lb + rng() % std::min<uint64_t>(csa.size() - lb, 1 + (q % 10) * 500);
+        vector<uint64_t> expected(csa.doc_array.begin() + lb, csa.doc_array.begin() + rb + 1), res;
+        sort(expected.begin(), expected.end());
+        expected.erase(unique(expected.begin(), expected.end()), expected.end());
+        csa.list_docs(lb, rb, back_inserter(res));
+        sort(res.begin(), res.end());
+        ASSERT_EQ(expected, res) << " lb=" << lb << " rb=" << rb;
+    }
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cstdlib>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -7,6 +8,7 @@
 #include <sdsl/csa_sada.hpp>
 #include <sdsl/csa_wt.hpp>
 #include <sdsl/enc_vector.hpp>
+#include <sdsl/qgram_table.hpp>
 #include <sdsl/suffix_array_algorithm.hpp>
 
 #include "common.hpp"
@@ -224,6 +226,57 @@ TYPED_TEST(csa_int_test, psi_lf_access)
     }
 }
 
+//! Test the q-gram table against backward_search
+TYPED_TEST(csa_int_test, qgram_table)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    if (csa.size() < 2)
+        return;
+    for (uint64_t budget : {0ULL, 1ULL << 12, 1ULL << 20})
+    {
+        sdsl::qgram_table<TypeParam> table(csa, budget);
+        std::mt19937_64 rng(13);
+        for (size_type k = 0; k < 200; ++k)
+        {
+            size_type len = 1 + rng() % (2 * table.q + 1);
+            size_type pos = rng() % (csa.size() - 1);
+            auto pat = extract(csa, pos, std::min(csa.size() - 2, pos + len - 1));
+            size_type lb = 0, rb = 0, l_res = 0, r_res = 0;
+            auto cnt = backward_search(csa, 0, csa.size() - 1, pat.begin(), pat.end(), lb, rb);
+            ASSERT_EQ(cnt, table.search(pat.begin(), pat.end(), l_res, r_res));
+            if (cnt > 0)
+            {
+                ASSERT_EQ(lb, l_res);
+                ASSERT_EQ(rb, r_res);
+            }
+        }
+    }
+}
+
+//! Test that counting a set of patterns equals counting each pattern
+TYPED_TEST(csa_int_test, count_batch)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    if (csa.size() < 2)
+        return;
+    std::mt19937_64 rng(17);
+    std::vector<typename TypeParam::string_type> patterns;
+    for (size_type k = 0; k < 300; ++k)
+    {
+        size_type end = k % 2 ? k % (csa.size() - 1) : rng() % (csa.size() - 1);
+        size_type len = 1 + rng() % 10;
+        patterns.push_back(extract(csa, end >= len ? end - len + 1 : 0, end));
+    }
+    for (uint64_t threads : {1, 3})
+    {
+        auto cnt = sdsl::count(csa, patterns, threads);
+        for (size_type i = 0; i < patterns.size(); ++i)
+            ASSERT_EQ(sdsl::count(csa, patterns[i].begin(), patterns[i].end()), cnt[i]);
+    }
+}
+
 //! Test access after swap
 TYPED_TEST(csa_int_test, swap_test)
 {
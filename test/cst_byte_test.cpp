@@ -1,12 +1,16 @@
+#include <algorithm>
 #include <random>
 #include <set>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <sdsl/cst_fully.hpp>
+#include <sdsl/cst_node_cache.hpp>
 #include <sdsl/cst_sada.hpp>
 #include <sdsl/cst_sct3.hpp>
+#include <sdsl/suffix_tree_algorithm.hpp>
 
 #include "common.hpp"
 #include "cst_helper.hpp"
@@ -522,6 +526,188 @@ TYPED_TEST(cst_byte_test, bottom_up_iterator)
     //    TODO: implement
 }
 
+//! Test matching statistics and (super-)maximal exact matches
+TYPED_TEST(cst_byte_test, matching_statistics)
+{
+    TypeParam cst;
+    ASSERT_TRUE(load_from_file(cst, temp_file));
+    int_vector<8> text;
+    ASSERT_TRUE(load_vector_from_file(text, test_file, 1));
+    std::mt19937_64 rng(13);
+    std::vector<std::string> queries;
+    for (size_type q = 0; q < 20; ++q)
+    {
+        std::string query;
+        size_type pos = text.size() ? rng() % text.size() : 0;
+        for (size_type i = 0; i < 60 and pos + i < text.size(); ++i)
+            query.push_back(rng() % 10 ? text[pos + i] : 'a' + rng() % 26); // mutate 10% of the symbols
+        query.push_back('X');
+        queries.push_back(query);
+    }
+    auto ms_batch = matching_statistics(cst, queries, 3);
+    ASSERT_EQ(ms_batch, matching_statistics(cst, queries, 0));
+    std::vector<std::vector<exact_match>> smems_batch(queries.size());
+    super_maximal_exact_matches(
+        cst,
+        queries,
+        2,
+        [&](size_type q, exact_match const & m)
+        {
+            smems_batch[q].push_back(m);
+        },
+        3);
+    size_type const mem_min_len = 8;
+    std::vector<std::vector<maximal_exact_match>> mems_batch(queries.size());
+    maximal_exact_matches(
+        cst,
+        queries,
+        mem_min_len,
+        [&](size_type q, maximal_exact_match const & m)
+        {
+            mems_batch[q].push_back(m);
+        },
+        0);
+    for (size_type q = 0; q < queries.size(); ++q)
+    {
+        std::string const & query = queries[q];
+        auto ms = matching_statistics(cst, query.begin(), query.end());
+        ASSERT_EQ(ms, ms_batch[q]);
+        std::vector<exact_match> smems;
+        for (size_type i = 0; i < query.size(); ++i)
+        {
+            size_type len = 0;
+            while (i + len < query.size() and count(cst.csa, query.begin() + i, query.begin() + i + len + 1) > 0)
+                ++len;
+            ASSERT_EQ(len, ms[i]) << "i=" << i;
+            if (len >= 2 and (i == 0 or ms[i - 1] != len + 1))
+            {
+                exact_match m;
+                m.query_pos = i;
+                m.len = len;
+                backward_search(cst.csa, 0, cst.csa.size() - 1, query.begin() + i, query.begin() + i + len, m.lb, m.rb);
+                smems.push_back(m);
+            }
+        }
+        std::vector<exact_match> smems2;
+        super_maximal_exact_matches(cst,
+                                    query.begin(),
+                                    query.end(),
+                                    2,
+                                    [&](exact_match const & m)
+                                    {
+                                        smems2.push_back(m);
+                                    });
+        ASSERT_EQ(smems, smems2);
+        ASSERT_EQ(smems, smems_batch[q]);
+
+        // MEMs: all left- and right-maximal pairs of positions
+        std::vector<std::tuple<size_type, size_type, size_type>> mems, mems2;
+        for (size_type i = 0; i < query.size(); ++i)
+        {
+            for (size_type len = mem_min_len; len <= ms[i]; ++len)
+            {
+                size_type lb, rb;
+                backward_search(cst.csa, 0, cst.csa.size() - 1, query.begin() + i, query.begin() + i + len, lb, rb);
+                for (size_type k = lb; k <= rb; ++k)
+                {
+                    size_type p = cst.csa[k];
+                    bool right_max = i + len == query.size() or p + len == text.size()
+                                  or text[p + len] != (uint8_t)query[i + len];
+                    bool left_max = i == 0 or p == 0 or text[p - 1] != (uint8_t)query[i - 1];
+                    if (right_max and left_max)
+                        mems.emplace_back(i, p, len);
+                }
+            }
+        }
+        size_type last_pos = 0;
+        for (auto const & m : mems_batch[q])
+        {
+            ASSERT_LE(last_pos, m.query_pos);
+            last_pos = m.query_pos;
+            mems2.emplace_back(m.query_pos, m.text_pos, m.len);
+        }
+        std::sort(mems.begin(), mems.end());
+        std::sort(mems2.begin(), mems2.end());
+        ASSERT_EQ(mems, mems2) << "q=" << q;
+    }
+}
+
+//! Test the node cache
+TYPED_TEST(cst_byte_test, node_cache)
+{
+    TypeParam cst;
+    ASSERT_TRUE(load_from_file(cst, temp_file));
+    cst_node_cache<TypeParam> cache(cst, 4);
+    for (size_type round = 0; round < 2; ++round)
+    {
+        size_type cnt = 0;
+        for (auto v : cst)
+        {
+            if (++cnt > 10000)
+                break;
+            ASSERT_EQ(cst.depth(v), cache.depth(v));
+            ASSERT_EQ(cst.sl(v), cache.sl(v));
+            if (cst.is_leaf(v))
+                continue;
+            size_type d = cst.depth(v);
+            std::vector<typename TypeParam::node_type> children, cached;
+            std::vector<typename TypeParam::char_type> cs;
+            for (auto w = cst.select_child(v, 1); w != cst.root(); w = cst.sibling(w))
+            {
+                children.push_back(w);
+                cs.push_back(cst.edge(w, d + 1));
+                ASSERT_EQ(cst.wl(v, cs.back()), cache.wl(v, cs.back()));
+            }
+            std::vector<typename TypeParam::node_type> vs(children.size(), v);
+            cache.child(vs.begin(), vs.end(), cs.begin(), std::back_inserter(cached));
+            ASSERT_EQ(children, cached);
+        }
+    }
+    ASSERT_LT(0ULL, cache.hits());
+
+    // interleaved requests for several nodes, including characters without a child
+    std::vector<typename TypeParam::node_type> vs, expected, cached;
+    std::vector<typename TypeParam::char_type> cs;
+    size_type cnt = 0;
+    for (auto v : cst)
+    {
+        if (++cnt > 200)
+            break;
+        for (int c = 255; c > 0; c -= 7)
+        {
+            vs.push_back(v);
+            cs.push_back(c);
+            expected.push_back(cst.child(v, c));
+        }
+        vs.push_back(cst.root());
+        cs.push_back(cs.back());
+        expected.push_back(cst.child(cst.root(), cs.back()));
+    }
+    cache.clear();
+    cache.child(vs.begin(), vs.end(), cs.begin(), std::back_inserter(cached));
+    ASSERT_EQ(expected, cached);
+}
+
+//! Test that the parallel construction yields the same tree as the sequential one
+TYPED_TEST(cst_byte_test, parallel_construction)
+{
+    uint64_t num_threads = construct_config().num_threads;
+    std::string temp_file2 = sdsl::tmp_file(temp_dir + "/" + util::basename(test_file), util::basename(test_file));
+    TypeParam cst_seq, cst_par;
+    {
+        construct_config().num_threads = 1;
+        cache_config config(true, temp_dir, util::basename(temp_file2));
+        construct(cst_seq, test_file, config, 1);
+    }
+    {
+        construct_config().num_threads = 3;
+        cache_config config(true, temp_dir, util::basename(temp_file2));
+        construct(cst_par, test_file, config, 1);
+    }
+    construct_config().num_threads = num_threads;
+    ASSERT_TRUE(cst_seq == cst_par);
+}
+
 #if SDSL_HAS_CEREAL
 template <typename in_archive_t, typename out_archive_t, typename TypeParam>
 void do_serialisation(TypeParam const & l)
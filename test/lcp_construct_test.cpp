@@ -18,6 +18,16 @@ namespace
 string test_file, temp_dir, temp_file;
 typedef map<string, void (*)(cache_config &)> tMSFP; // map <name, lcp method>
 
+// Runs the LCP construction t_construct with t_threads threads
+template <void (*t_construct)(cache_config &), uint64_t t_threads>
+void construct_with_threads(cache_config & config)
+{
+    uint64_t num_threads = construct_config().num_threads;
+    construct_config().num_threads = t_threads;
+    t_construct(config);
+    construct_config().num_threads = num_threads;
+}
+
 class lcp_construct_test : public ::testing::Test
 {
 protected:
@@ -36,8 +46,12 @@ protected:
         lcp_function["semi_extern_PHI"] = &construct_lcp_semi_extern_PHI;
         lcp_function["go"] = &construct_lcp_go;
         lcp_function["goPHI"] = &construct_lcp_goPHI;
-        lcp_function["bwt_based"] = &construct_lcp_bwt_based<>;
-        lcp_function["bwt_based2"] = &construct_lcp_bwt_based2<>;
+        lcp_function["bwt_based"] = &construct_with_threads<&construct_lcp_bwt_based<>, 1>;
+        lcp_function["bwt_based2"] = &construct_with_threads<&construct_lcp_bwt_based2<>, 1>;
+        lcp_function["bwt_based_parallel"] = &construct_with_threads<&construct_lcp_bwt_based<>, 3>;
+        lcp_function["bwt_based2_parallel"] = &construct_with_threads<&construct_lcp_bwt_based2<>, 3>;
+        lcp_function["bwt_based_0_threads"] = &construct_with_threads<&construct_lcp_bwt_based<>, 0>;
+        lcp_function["bwt_based2_0_threads"] = &construct_with_threads<&construct_lcp_bwt_based2<>, 0>;
 
         uint8_t num_bytes = 1;
         {
@@ -0,0 +1,193 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sdsl/construct.hpp>
+#include <sdsl/construct_lcp.hpp>
+#include <sdsl/csa_wt.hpp>
+#include <sdsl/lz_factorization.hpp>
+
+#include "common.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace sdsl;
+using namespace std;
+
+namespace
+{
+string test_file, temp_dir, temp_file;
+
+typedef vector<pair<uint64_t, uint64_t>> phrase_list;
+
+class lz_factorization_test : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        config = cache_config(false, temp_dir, to_string(util::pid()));
+        ASSERT_TRUE(load_vector_from_file(text, test_file, 1));
+        ASSERT_TRUE(contains_no_zero_symbol(text, test_file));
+        append_zero_symbol(text);
+        ASSERT_TRUE(store_to_cache(text, conf::KEY_TEXT, config));
+        sa = int_vector<>(text.size(), 0, bits::hi(text.size()) + 1);
+        algorithm::calculate_sa((unsigned char const *)text.data(), text.size(), sa);
+        ASSERT_TRUE(store_to_cache(sa, conf::KEY_SA, config));
+    }
+
+    virtual void TearDown()
+    {
+        util::delete_all_files(config.file_map);
+    }
+
+    // Decodes the phrases; copies refer to the decoded text itself (LZ77) or to ref (RLZ)
+    template <class t_ref>
+    vector<uint64_t> decode(phrase_list const & phrases, t_ref const * ref)
+    {
+        vector<uint64_t> res;
+        for (auto const & p : phrases)
+        {
+            if (p.second == 0)
+                res.push_back(p.first);
+            for (uint64_t k = 0; k < p.second; ++k)
+                res.push_back(ref ? (*ref)[p.first + k] : res[p.first + k]);
+        }
+        return res;
+    }
+
+    cache_config config;
+    int_vector<8> text;
+    int_vector<> sa;
+};
+
+TEST_F(lz_factorization_test, lz77)
+{
+    uint64_t n = text.size() - 1;
+    phrase_list phrases;
+    uint64_t z = lz77_factorize(text,
+                                n,
+                                sa,
+                                [&](uint64_t x, uint64_t len)
+                                {
+                                    phrases.emplace_back(x, len);
+                                });
+    ASSERT_EQ(phrases.size(), z);
+    auto decoded = decode<int_vector<8>>(phrases, nullptr);
+    ASSERT_EQ(n, decoded.size());
+    for (uint64_t i = 0; i < n; ++i)
+        ASSERT_EQ(text[i], decoded[i]) << "i=" << i;
+    // greedy: no copy can be extended and each literal is a new symbol
+    uint64_t i = 0;
+    for (auto const & p : phrases)
+    {
+        if (p.second == 0)
+        {
+            for (uint64_t j = 0; j < i; ++j)
+                ASSERT_NE(text[j], text[i]) << "literal at " << i << " occurs before";
+            i += 1;
+        }
+        else
+        {
+            ASSERT_LT(p.first, i);
+            i += p.second;
+            if (i < n and n < 10000)
+            {
+                for (uint64_t j = 0; j + p.second < i; ++j)
+                {
+                    uint64_t l = 0;
+                    while (i - p.second + l < n and text[j + l] == text[i - p.second + l])
+                        ++l;
+                    ASSERT_LE(l, p.second) << "phrase ending at " << i << " is not the longest";
+                }
+            }
+        }
+    }
+}
+
+TEST_F(lz_factorization_test, construct_lz77)
+{
+    phrase_list phrases;
+    lz77_factorize(text,
+                   text.size() - 1,
+                   sa,
+                   [&](uint64_t x, uint64_t len)
+                   {
+                       phrases.emplace_back(x, len);
+                   });
+    construct_lz77<8>(config);
+    int_vector<> lz;
+    ASSERT_TRUE(load_from_cache(lz, conf::KEY_LZ77, config));
+    ASSERT_EQ(2 * phrases.size(), lz.size());
+    for (uint64_t k = 0; k < phrases.size(); ++k)
+    {
+        ASSERT_EQ(phrases[k].first, lz[2 * k]);
+        ASSERT_EQ(phrases[k].second, lz[2 * k + 1]);
+    }
+}
+
+TEST_F(lz_factorization_test, construct_lz77_semi_extern)
+{
+    construct_lz77<8>(config);
+    int_vector<> lz;
+    ASSERT_TRUE(load_from_cache(lz, conf::KEY_LZ77, config));
+    construct_lcp_kasai<8>(config);
+    uint64_t num_threads = construct_config().num_threads;
+    for (uint64_t threads : {0, 1, 3})
+    {
+        for (uint64_t block_size : {1, 7, 1000, 10000, 1 << 20})
+        {
+            if (text.size() / block_size > 100) // keep the number of scans small
+                continue;
+            construct_config().num_threads = threads;
+            construct_lz77_semi_extern<8>(config, block_size);
+            int_vector<> lz_se;
+            ASSERT_TRUE(load_from_cache(lz_se, conf::KEY_LZ77, config));
+            ASSERT_EQ(lz, lz_se) << "threads=" << threads << " block_size=" << block_size;
+        }
+    }
+    construct_config().num_threads = num_threads;
+}
+
+TEST_F(lz_factorization_test, rlz)
+{
+    // reference: first half of the text; target: second half
+    uint64_t n = text.size() - 1, half = n / 2;
+    int_vector<8> ref(half), target(n - half);
+    for (uint64_t i = 0; i < half; ++i)
+        ref[i] = text[i];
+    for (uint64_t i = half; i < n; ++i)
+        target[i - half] = text[i];
+    csa_wt<> csa;
+    construct_im(csa, string(ref.begin(), ref.end()), 1);
+    phrase_list sequential;
+    for (uint64_t threads : {1, 0, 3, 8})
+    {
+        phrase_list phrases;
+        auto report = [&](uint64_t x, uint64_t len)
+        {
+            phrases.emplace_back(x, len);
+        };
+        uint64_t z = threads == 1 ? rlz_factorize(csa, target.begin(), target.end(), report)
+                                  : rlz_factorize(csa, target.begin(), target.end(), report, threads);
+        ASSERT_EQ(phrases.size(), z);
+        auto decoded = decode(phrases, &ref);
+        ASSERT_EQ(target.size(), decoded.size());
+        for (uint64_t i = 0; i < target.size(); ++i)
+            ASSERT_EQ(target[i], decoded[i]) << "i=" << i;
+        if (threads == 1)
+            sequential = phrases;
+        ASSERT_EQ(sequential, phrases) << "threads=" << threads;
+    }
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    if (init_2_arg_test(argc, argv, "LZ_FACTORIZATION", test_file, temp_dir, temp_file) != 0)
+    {
+        return 1;
+    }
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,162 @@
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sdsl/bp_support_sada.hpp>
+#include <sdsl/fast_cache.hpp>
+#include <sdsl/suffix_arrays.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using namespace sdsl;
+using namespace std;
+
+class query_cache_test : public ::testing::Test
+{
+protected:
+    virtual void TearDown()
+    {
+        query_cache_config().enabled = false;
+        query_cache_config().log_size = 10;
+    }
+};
+
+TEST_F(query_cache_test, lru_replacement)
+{
+    fast_cache cache(2); // one set with 4 ways
+    uint64_t x = 0;
+    for (uint64_t i = 0; i < 4; ++i)
+        cache.write(7, i, 10 * i);
+    ASSERT_TRUE(cache.exists(7, 0, x));
+    ASSERT_EQ(0ULL, x);
+    ASSERT_FALSE(cache.exists(8, 0, x)); // other owner
+    cache.write(7, 4, 40);               // replaces 1, the least recently used entry
+    ASSERT_FALSE(cache.exists(7, 1, x));
+    for (uint64_t i : {0, 2, 3, 4})
+    {
+        ASSERT_TRUE(cache.exists(7, i, x));
+        ASSERT_EQ(10 * i, x);
+    }
+    ASSERT_EQ(5ULL, cache.hits());
+    ASSERT_EQ(2ULL, cache.misses());
+}
+
+string random_text(uint64_t n, uint64_t seed)
+{
+    mt19937_64 rng(seed);
+    string text(n, 'a');
+    for (auto & c : text)
+        c = 'a' + rng() % 4;
+    return text;
+}
+
+TEST_F(query_cache_test, csa_wt)
+{
+    csa_wt<> csa, csa2;
+    construct_im(csa, random_text(5000, 1), 1);
+    construct_im(csa2, random_text(5000, 2), 1);
+    vector<uint64_t> sa(csa.size()), sa2(csa2.size());
+    for (uint64_t i = 0; i < csa.size(); ++i)
+        sa[i] = csa[i];
+    for (uint64_t i = 0; i < csa2.size(); ++i)
+        sa2[i] = csa2[i];
+
+    query_cache_config().enabled = true;
+    query_cache_config().log_size = 8;
+    auto check = [&](csa_wt<> const & c, vector<uint64_t> const & expected)
+    {
+        for (uint64_t round = 0; round < 2; ++round)
+            for (uint64_t i = 0; i < 1000; ++i)
+                ASSERT_EQ(expected[i], c[i]);
+    };
+    uint64_t hits = query_cache(query_cache_kind::sa).hits();
+    check(csa, sa);
+    ASSERT_LT(hits, query_cache(query_cache_kind::sa).hits());
+    check(csa2, sa2);
+    csa = csa2; // answers of the old content must not be reused
+    check(csa, sa2);
+
+    // each thread uses its own cache
+    vector<thread> threads;
+    for (uint64_t t = 0; t < 3; ++t)
+        threads.emplace_back(
+            [&]()
+            {
+                check(csa2, sa2);
+            });
+    for (auto & t : threads)
+        t.join();
+
+    // the configuration can be changed while other threads run queries
+    threads.clear();
+    for (uint64_t t = 0; t < 3; ++t)
+        threads.emplace_back(
+            [&]()
+            {
+                check(csa2, sa2);
+            });
+    for (uint64_t round = 0; round < 100; ++round)
+    {
+        query_cache_config().enabled = round % 2;
+        query_cache_config().log_size = 4 + round % 8;
+    }
+    for (auto & t : threads)
+        t.join();
+}
+
+TEST_F(query_cache_test, bp_support_sada)
+{
+    // random balanced parentheses sequence
+    mt19937_64 rng(3);
+    uint64_t n = 20000;
+    bit_vector bp(2 * n, 0);
+    for (uint64_t i = 0, open = 0, excess = 0; i < 2 * n; ++i)
+    {
+        if (open < n and (excess == 0 or rng() % 2))
+        {
+            bp[i] = 1;
+            ++open;
+            ++excess;
+        }
+        else
+        {
+            --excess;
+        }
+    }
+    bp_support_sada<> bps(&bp);
+    vector<uint64_t> fc(bp.size()), fo(bp.size()), sel(n);
+    for (uint64_t i = 0; i < bp.size(); ++i)
+    {
+        fc[i] = bps.find_close(i);
+        fo[i] = bps.find_open(i);
+    }
+    for (uint64_t i = 0; i < n; ++i)
+        sel[i] = bps.select(i + 1);
+
+    query_cache_config().enabled = true;
+    for (uint64_t round = 0; round < 2; ++round)
+    {
+        for (uint64_t i = 0; i < 600; ++i)
+        {
+            ASSERT_EQ(fc[i], bps.find_close(i));
+            ASSERT_EQ(fo[i], bps.find_open(i));
+        }
+        for (uint64_t i = 0; i < 600; ++i)
+            ASSERT_EQ(sel[i], bps.select(i + 1));
+    }
+    ASSERT_LT(0ULL, query_cache(query_cache_kind::find_close).hits());
+    ASSERT_LT(0ULL, query_cache(query_cache_kind::find_open).hits());
+    ASSERT_LT(0ULL, query_cache(query_cache_kind::select).hits());
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
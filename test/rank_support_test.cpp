@@ -2,6 +2,7 @@
 
 #include <sdsl/bit_vector_il.hpp>
 #include <sdsl/hyb_vector.hpp>
+#include <sdsl/mix_vector.hpp>
 #include <sdsl/rank_support_scan.hpp>
 #include <sdsl/rank_support_v.hpp>
 #include <sdsl/rank_support_v5.hpp>
@@ -41,6 +42,8 @@ typedef Types<rank_support_il<1, 512>,
               rank_support_sd<0>,
               rank_support_hyb<1>,
               rank_support_hyb<0>,
+              rank_support_mix<1, 1024>,
+              rank_support_mix<0, 1024>,
               rank_support_v<10, 2>,
               rank_support_v<01, 2>,
               rank_support_v<00, 2>,
@@ -91,6 +94,8 @@ typedef Types<rank_support_il<1, 512>,
               rank_support_sd<0>,
               rank_support_hyb<1>,
               rank_support_hyb<0>,
+              rank_support_mix<1, 1024>,
+              rank_support_mix<0, 1024>,
               rank_support_v<10, 2>,
               rank_support_v<01, 2>,
               rank_support_v<00, 2>,
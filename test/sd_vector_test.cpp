@@ -82,6 +82,32 @@ TYPED_TEST(sd_vector_test, builder_empty_constructor)
     }
 }
 
+TYPED_TEST(sd_vector_test, rank_clustered)
+{
+    // few ones overall (large low part) but dense clusters, so many ones share a high part
+    bit_vector bv(BV_SIZE * 16);
+    std::mt19937_64 rng(17);
+    for (size_t c = 0; c < 8; ++c)
+    {
+        size_t start = rng() % (bv.size() - 5000);
+        for (size_t i = start; i < start + 5000; ++i)
+            bv[i] = bv[i] | (rng() % 3 == 0) | (c == 0);
+    }
+    for (size_t k = 0; k < 100; ++k)
+        bv[rng() % bv.size()] = 1;
+    TypeParam sdv(bv);
+    typename TypeParam::rank_1_type rank1(&sdv);
+    typename TypeParam::rank_0_type rank0(&sdv);
+    size_t ones = 0;
+    for (size_t i = 0; i <= bv.size(); ++i)
+    {
+        ASSERT_EQ(ones, rank1(i));
+        ASSERT_EQ(i - ones, rank0(i));
+        if (i < bv.size())
+            ones += bv[i];
+    }
+}
+
 } // end namespace
 
 int main(int argc, char * argv[])
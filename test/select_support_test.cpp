@@ -2,6 +2,7 @@
 
 #include <sdsl/bit_vector_il.hpp>
 #include <sdsl/hyb_vector.hpp>
+#include <sdsl/mix_vector.hpp>
 #include <sdsl/rrr_vector.hpp>
 #include <sdsl/sd_vector.hpp>
 #include <sdsl/select_support_mcl.hpp>
@@ -36,6 +37,8 @@ typedef Types<select_support_mcl<>,
               select_support_il<1, 512>,
               select_support_mcl<0>,
               select_support_il<0, 512>,
+              select_support_mix<1, 1024>,
+              select_support_mix<0, 1024>,
               select_support_mcl<01, 2>,
               select_support_mcl<10, 2>,
               select_support_mcl<00, 2>,
@@ -71,6 +74,8 @@ typedef Types<select_support_mcl<>,
               select_support_mcl<0>,
               select_support_rrr<0>,
               select_support_il<0, 512>,
+              select_support_mix<1, 1024>,
+              select_support_mix<0, 1024>,
               select_support_mcl<01, 2>,
               select_support_mcl<10, 2>,
               select_support_mcl<00, 2>,
@@ -5,6 +5,7 @@
 
 #include <sdsl/bit_vector_il.hpp>
 #include <sdsl/construct.hpp>
+#include <sdsl/mix_vector.hpp>
 #include <sdsl/rank_support_v.hpp>
 #include <sdsl/rank_support_v5.hpp>
 #include <sdsl/rrr_vector.hpp>
@@ -47,6 +48,8 @@ typedef Types<wt_rlmn<>,
               wt_huff<bit_vector, rank_support_v<>>,
               wt_huff<bit_vector, rank_support_v5<>>,
               wt_huff<rrr_vector<63>>,
+              wt_huff<mix_vector<>>,
+              wt_huff<mix_vector<1024, 100>>,
               wt_rlmn<bit_vector>,
               wt_gmr_rs<>,
               wt_hutu<bit_vector_il<>>,
@@ -57,7 +60,7 @@ typedef Types<wt_rlmn<>,
 
 #else
 
-typedef Types<wt_blcd<>, wt_huff<>, wt_hutu<>, wt_rlmn<>, wt_gmr_rs<>> Implementations;
+typedef Types<wt_blcd<>, wt_huff<>, wt_huff<mix_vector<1024>>, wt_hutu<>, wt_rlmn<>, wt_gmr_rs<>> Implementations;
 
 #endif
 
@@ -167,6 +170,23 @@ TYPED_TEST(wt_byte_test, rank)
     }
 }
 
+//! Test rank_pair
+TYPED_TEST(wt_byte_test, rank_pair)
+{
+    TypeParam wt;
+    ASSERT_TRUE(load_from_file(wt, temp_file));
+    std::mt19937_64 rng(5);
+    for (size_type k = 0; k < 10000; ++k)
+    {
+        size_type i = rng() % (wt.size() + 1);
+        size_type j = i + rng() % (std::min((size_type)300, wt.size() - i) + 1);
+        unsigned char c = (k % 2 == 0 and i < wt.size()) ? wt[i] : rng() % 256;
+        auto ranks = wt.rank_pair(i, j, c);
+        ASSERT_EQ(wt.rank(i, c), ranks.first) << " i=" << i << " c=" << (size_type)c;
+        ASSERT_EQ(wt.rank(j, c), ranks.second) << " j=" << j << " c=" << (size_type)c;
+    }
+}
+
 //! Test select methods
 TYPED_TEST(wt_byte_test, select)
 {
@@ -183,6 +203,26 @@ TYPED_TEST(wt_byte_test, select)
     }
 }
 
+//! Test select on a sequence of long runs, where the ones and zeros of the tree bit vector are clustered
+TYPED_TEST(wt_byte_test, select_runs)
+{
+    std::mt19937_64 rng(11);
+    std::string text;
+    while (text.size() < 1000000)
+    {
+        text.append(1 + rng() % 5000, (char)('a' + rng() % 5));
+    }
+    TypeParam wt;
+    construct_im(wt, text, 1);
+    vector<size_type> cnt(256, 0);
+    for (size_type j = 0; j < text.size(); ++j)
+    {
+        unsigned char c = text[j];
+        cnt[c]++;
+        ASSERT_EQ(j, wt.select(cnt[c], c)) << " j = " << j;
+    }
+}
+
 //! Test inverse select method
 TYPED_TEST(wt_byte_test, inverse_select)
 {
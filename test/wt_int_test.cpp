@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <map>
 #include <queue>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -141,6 +142,29 @@ TYPED_TEST(wt_int_test, load_and_rank)
     }
 }
 
+//! Test the load method and rank_pair method
+TYPED_TEST(wt_int_test, load_and_rank_pair)
+{
+    int_vector<> iv;
+    load_from_file(iv, test_file);
+    TypeParam wt;
+    ASSERT_TRUE(load_from_file(wt, temp_file));
+    ASSERT_EQ(iv.size(), wt.size());
+    std::mt19937_64 rng(5);
+    for (size_type k = 0; k < 10000; ++k)
+    {
+        size_type i = rng() % (wt.size() + 1);
+        size_type j = i + rng() % (std::min((size_type)300, wt.size() - i) + 1);
+        // symbols of the text and (possibly) absent symbols
+        uint64_t c = k;
+        if (i < wt.size())
+            c = (k % 2 == 0) ? iv[i] : iv[rng() % iv.size()] + k % 3;
+        auto ranks = wt.rank_pair(i, j, c);
+        ASSERT_EQ(wt.rank(i, c), ranks.first) << " i=" << i << " c=" << c;
+        ASSERT_EQ(wt.rank(j, c), ranks.second) << " j=" << j << " c=" << c;
+    }
+}
+
 //! Test the load method and rank method
 TYPED_TEST(wt_int_test, load_and_move_and_rank)
 {